@@ -0,0 +1,324 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred calls.  This #if is closed at the very bottom of this
+file.  If you want to include the deferred daemon then ensure
+configUSE_DEFERRED_CALLS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_DEFERRED_CALLS == 1 )
+
+#if ( ( configDEFERRED_QUEUE_LENGTH & ( configDEFERRED_QUEUE_LENGTH - 1 ) ) != 0 )
+	#error configDEFERRED_QUEUE_LENGTH must be a power of two
+#endif
+
+#define deferredINDEX_MASK		( ( unsigned long ) configDEFERRED_QUEUE_LENGTH - 1UL )
+
+/* One slot of the ring.  ulSequence says whose turn the slot is: equal to the
+position the next call to claim it will have, one more once that call is
+published, and a whole ring more once the daemon has taken it out, which
+frees the slot for the call one time round later. */
+typedef struct deferredCall
+{
+	unsigned long ulSequence;
+	deferredPENDED_FUNCTION pxFunction;
+	void *pvParameter1;
+	unsigned long ulParameter2;
+	unsigned long ulTimestamp;		/*< configDEFERRED_TIMESTAMP() when pended. */
+} xDEFERRED_CALL;
+
+/* Volatile so that the compiler keeps the stores of a call ahead of the
+sequence number store that publishes it.  The Cortex-M3 itself does not
+reorder them. */
+PRIVILEGED_DATA static volatile xDEFERRED_CALL xCalls[ configDEFERRED_QUEUE_LENGTH ];
+
+/* Positions of the next slot to claim and of the next call to make.  They
+only ever count up, the slot is the position modulo the ring length. */
+PRIVILEGED_DATA static volatile unsigned long ulHead = 0UL;
+PRIVILEGED_DATA static volatile unsigned long ulTail = 0UL;
+
+PRIVILEGED_DATA static xTaskHandle xDeferredTaskHandle = NULL;
+
+/* Updated by the daemon only, apart from the overflows, which interrupts
+count. */
+PRIVILEGED_DATA static xDeferredStats xStats;
+PRIVILEGED_DATA static volatile unsigned long ulOverflows = 0UL;
+
+/* Ports without an atomic compare-and-swap mask interrupts around a plain
+compare and store instead.  Only interrupts claim slots, so the FromISR mask
+is the right one. */
+#ifndef portCOMPARE_AND_SWAP
+
+	static portBASE_TYPE prvCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExpected, unsigned long ulNew )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( *pulDestination == ulExpected )
+			{
+				*pulDestination = ulNew;
+				xReturn = pdTRUE;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+	#define portCOMPARE_AND_SWAP( pulDestination, ulExpected, ulNew ) prvCompareAndSwap( ( pulDestination ), ( ulExpected ), ( ulNew ) )
+
+#endif
+
+/*
+ * The daemon task.
+ */
+static void prvDeferredTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take the call at the tail out of the ring and make it.  Returns pdFALSE,
+ * without calling anything, if the ring is empty.
+ */
+static portBASE_TYPE prvCallNext( void ) PRIVILEGED_FUNCTION;
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDeferredCreateDaemonTask( void )
+{
+portBASE_TYPE xReturn;
+unsigned long ulSlot;
+
+	/* Called when the scheduler is started.  Interrupts that call the kernel
+	stay masked until it runs the first task, so none can pend a call before
+	the ring is set up. */
+	for( ulSlot = 0UL; ulSlot < ( unsigned long ) configDEFERRED_QUEUE_LENGTH; ulSlot++ )
+	{
+		xCalls[ ulSlot ].ulSequence = ulSlot;
+	}
+
+	xReturn = xTaskCreate( prvDeferredTask, ( const signed char * ) "Deferred", ( unsigned short ) configDEFERRED_TASK_STACK_DEPTH, NULL, ( unsigned portBASE_TYPE ) configDEFERRED_TASK_PRIORITY, &xDeferredTaskHandle );
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPendFunctionCallFromISR( deferredPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned long ulTimestamp = configDEFERRED_TIMESTAMP(), ulPosition, ulCount;
+volatile xDEFERRED_CALL *pxCall;
+long lDifference;
+
+	configASSERT( xFunctionToPend );
+	configASSERT( xDeferredTaskHandle );
+
+	/* Claim the slot at the head.  An interrupt that nests inside this one
+	may claim it first, in which case the head has moved on and the next slot
+	is tried; the nested interrupt finishes with its slot before this one
+	resumes, so the loop never waits on another. */
+	for( ;; )
+	{
+		ulPosition = ulHead;
+		pxCall = &( xCalls[ ulPosition & deferredINDEX_MASK ] );
+		lDifference = ( long ) ( pxCall->ulSequence - ulPosition );
+
+		if( lDifference == 0L )
+		{
+			if( portCOMPARE_AND_SWAP( &ulHead, ulPosition, ulPosition + 1UL ) != pdFALSE )
+			{
+				break;
+			}
+		}
+		else if( lDifference < 0L )
+		{
+			/* The slot still holds the call from one time round before, the
+			ring is full. */
+			do
+			{
+				ulCount = ulOverflows;
+			} while( portCOMPARE_AND_SWAP( &ulOverflows, ulCount, ulCount + 1UL ) == pdFALSE );
+
+			return pdFAIL;
+		}
+	}
+
+	pxCall->pxFunction = xFunctionToPend;
+	pxCall->pvParameter1 = pvParameter1;
+	pxCall->ulParameter2 = ulParameter2;
+	pxCall->ulTimestamp = ulTimestamp;
+	pxCall->ulSequence = ulPosition + 1UL;
+
+	/* Only the first call into an empty ring wakes the daemon.  While the
+	tail is short of this position the daemon has an earlier call to make, and
+	it keeps taking calls out until the ring is empty. */
+	if( ulTail == ulPosition )
+	{
+		vTaskNotifyGiveFromISR( xDeferredTaskHandle, pxHigherPriorityTaskWoken );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredGetStats( xDeferredStats *pxStats, portBASE_TYPE xReset )
+{
+	configASSERT( pxStats );
+
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xStats;
+		pxStats->ulOverflows = ulOverflows;
+
+		if( xReset != pdFALSE )
+		{
+			xStats.ulCalls = 0UL;
+			xStats.uxHighWaterMark = ( unsigned portBASE_TYPE ) 0U;
+			xStats.ulLatencyTotal = 0UL;
+			xStats.ulLatencyMax = 0UL;
+			ulOverflows = 0UL;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvCallNext( void )
+{
+unsigned long ulPosition = ulTail, ulLatency;
+volatile xDEFERRED_CALL *pxCall = &( xCalls[ ulPosition & deferredINDEX_MASK ] );
+deferredPENDED_FUNCTION pxFunction;
+void *pvParameter1;
+unsigned long ulParameter2;
+unsigned portBASE_TYPE uxWaiting;
+
+	if( pxCall->ulSequence != ulPosition + 1UL )
+	{
+		return pdFALSE;
+	}
+
+	pxFunction = pxCall->pxFunction;
+	pvParameter1 = pxCall->pvParameter1;
+	ulParameter2 = pxCall->ulParameter2;
+	ulLatency = configDEFERRED_TIMESTAMP() - pxCall->ulTimestamp;
+	uxWaiting = ( unsigned portBASE_TYPE ) ( ulHead - ulPosition );
+
+	/* Free the slot before making the call, the ring then has room for one
+	more while the function runs. */
+	pxCall->ulSequence = ulPosition + ( unsigned long ) configDEFERRED_QUEUE_LENGTH;
+	ulTail = ulPosition + 1UL;
+
+	/* Read by tasks in a critical section, and at the default priority no
+	task can run while the daemon is half way through an update. */
+	xStats.ulCalls++;
+	xStats.ulLatencyTotal += ulLatency;
+	if( ulLatency > xStats.ulLatencyMax )
+	{
+		xStats.ulLatencyMax = ulLatency;
+	}
+	if( uxWaiting > xStats.uxHighWaterMark )
+	{
+		xStats.uxHighWaterMark = uxWaiting;
+	}
+
+	pxFunction( pvParameter1, ulParameter2 );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredTask( void *pvParameters )
+{
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Notified by the call that found the ring empty. */
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		while( prvCallNext() != pdFALSE )
+		{
+			/* Until the ring is empty. */
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred calls.  If you want to include the deferred daemon then
+ensure configUSE_DEFERRED_CALLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_DEFERRED_CALLS == 1 */
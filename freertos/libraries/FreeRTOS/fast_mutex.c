@@ -0,0 +1,261 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "fast_mutex.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include fast mutex functionality.  This #if is closed at the very bottom of
+this file.  If you want to include fast mutexes then ensure
+configUSE_FAST_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_FAST_MUTEXES == 1 )
+
+#if ( configUSE_MUTEXES != 1 )
+	#error configUSE_FAST_MUTEXES requires configUSE_MUTEXES for priority inheritance
+#endif
+
+/* Set in the owner word while tasks may be waiting, so the holder's give
+cannot succeed on the fast path and goes through the kernel to wake one.  Task
+handles point to word aligned TCBs, so the bit is never part of one. */
+#define fastmutexCONTENDED		( 1UL )
+
+/* Ports without an atomic compare-and-swap get the same effect from a critical
+section.  Slower than the real thing but still without the queue code. */
+#ifndef portCOMPARE_AND_SWAP
+
+	static portBASE_TYPE prvCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExpected, unsigned long ulNew )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( *pulDestination == ulExpected )
+			{
+				*pulDestination = ulNew;
+				xReturn = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+	#define portCOMPARE_AND_SWAP( pulDestination, ulExpected, ulNew ) prvCompareAndSwap( ( pulDestination ), ( ulExpected ), ( ulNew ) )
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vFastMutexInitialise( xFastMutex *pxMutex )
+{
+	configASSERT( pxMutex );
+
+	pxMutex->ulOwner = 0UL;
+	pxMutex->ulContentions = 0UL;
+	vListInitialise( &( pxMutex->xTasksWaiting ) );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFastMutexTake( xFastMutex *pxMutex, portTickType xTicksToWait )
+{
+unsigned long ulSelf = ( unsigned long ) xTaskGetCurrentTaskHandle(), ulOwner;
+portBASE_TYPE xReturn = errQUEUE_BLOCKED, xBlocked = pdFALSE;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxMutex );
+
+	/* Uncontended, claim the free mutex with one exclusive store. */
+	if( portCOMPARE_AND_SWAP( &( pxMutex->ulOwner ), 0UL, ulSelf ) != pdFALSE )
+	{
+		return pdPASS;
+	}
+
+	/* Contended.  Every change to the owner word from here on is made in a
+	critical section, which no task can be inside a compare-and-swap across:
+	the exception that switches tasks clears the exclusive monitor and makes
+	the interrupted store fail. */
+	vTaskSetTimeOutState( &xTimeOut );
+
+	while( xReturn == errQUEUE_BLOCKED )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulOwner = pxMutex->ulOwner;
+
+			if( ulOwner == 0UL )
+			{
+				/* Given back since the compare-and-swap failed, and no task
+				was waiting to be handed it. */
+				pxMutex->ulOwner = ulSelf;
+				if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+				{
+					pxMutex->ulOwner |= fastmutexCONTENDED;
+				}
+				xReturn = pdPASS;
+			}
+			else if( ( xBlocked != pdFALSE ) && ( ( ulOwner & ~fastmutexCONTENDED ) == ulSelf ) )
+			{
+				/* xFastMutexGive() handed the mutex over while this task was
+				blocked. */
+				xReturn = pdPASS;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				/* Not recursive, a task waiting for itself never wakes. */
+				configASSERT( ( ulOwner & ~fastmutexCONTENDED ) != ulSelf );
+
+				pxMutex->ulOwner = ulOwner | fastmutexCONTENDED;
+				pxMutex->ulContentions++;
+
+				/* Lend the holder our priority until it gives the mutex. */
+				vTaskPriorityInherit( ( xTaskHandle * ) ( ulOwner & ~fastmutexCONTENDED ) );
+				vTaskPlaceOnEventList( &( pxMutex->xTasksWaiting ), xTicksToWait );
+				xBlocked = pdTRUE;
+
+				/* Switches away once the critical section is left. */
+				portYIELD_WITHIN_API();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFastMutexGive( xFastMutex *pxMutex )
+{
+unsigned long ulSelf = ( unsigned long ) xTaskGetCurrentTaskHandle();
+xList * const pxWaiting = &( pxMutex->xTasksWaiting );
+portBASE_TYPE xReturn = pdPASS;
+xTaskHandle xNext;
+
+	configASSERT( pxMutex );
+
+	/* Uncontended, the contended bit being clear means nobody waits. */
+	if( portCOMPARE_AND_SWAP( &( pxMutex->ulOwner ), ulSelf, 0UL ) != pdFALSE )
+	{
+		return pdPASS;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxMutex->ulOwner & ~fastmutexCONTENDED ) != ulSelf )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			/* Back to the base priority before a waiter is readied, so the
+			comparison deciding whether to yield sees it. */
+			vTaskPriorityDisinherit( ( xTaskHandle * ) ulSelf );
+
+			if( listLIST_IS_EMPTY( pxWaiting ) != pdFALSE )
+			{
+				/* The waiters timed out. */
+				pxMutex->ulOwner = 0UL;
+			}
+			else
+			{
+				/* Hand the mutex to the highest priority waiter rather than
+				free it, or a task taking it on the fast path meanwhile would
+				leave the remaining waiters unmarked. */
+				xNext = ( xTaskHandle ) listGET_OWNER_OF_HEAD_ENTRY( pxWaiting );
+
+				if( xTaskRemoveFromEventList( pxWaiting ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				pxMutex->ulOwner = ( unsigned long ) xNext;
+				if( listLIST_IS_EMPTY( pxWaiting ) == pdFALSE )
+				{
+					pxMutex->ulOwner |= fastmutexCONTENDED;
+				}
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include fast mutex functionality.  If you want to include fast mutexes
+then ensure configUSE_FAST_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_FAST_MUTEXES == 1 */
+
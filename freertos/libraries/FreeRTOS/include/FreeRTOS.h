@@ -149,6 +149,10 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_xTimerGetTimerDaemonTaskHandle 0
 #endif
 
+#ifndef INCLUDE_xTimerPendFunctionCall
+	#define INCLUDE_xTimerPendFunctionCall 0
+#endif
+
 #ifndef INCLUDE_pcTaskGetTaskName
 	#define INCLUDE_pcTaskGetTaskName 0
 #endif
@@ -161,6 +165,10 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_uxTaskGetStackHighWaterMark 0
 #endif
 
+#ifndef INCLUDE_vTaskWalkStacks
+	#define INCLUDE_vTaskWalkStacks 0
+#endif
+
 #ifndef configUSE_RECURSIVE_MUTEXES
 	#define configUSE_RECURSIVE_MUTEXES 0
 #endif
@@ -226,6 +234,11 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 #endif /* configUSE_TIMERS */
 
+/* Pended function calls are executed by the timer service task. */
+#if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS != 1 )
+	#error INCLUDE_xTimerPendFunctionCall requires configUSE_TIMERS to be set to 1
+#endif
+
 #ifndef INCLUDE_xTaskGetSchedulerState
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
@@ -428,6 +441,12 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_DELAY_UNTIL()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	/* Called by vTaskWaitForNextPeriod() when the task pxTCB completes a job
+	after its deadline. */
+	#define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
@@ -452,6 +471,78 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
 
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+	#define traceTASK_NOTIFY_WAIT()
+#endif
+
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY()
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR()
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceINCREASE_TICK_COUNT
+	#define traceINCREASE_TICK_COUNT( xTicksToJump )
+#endif
+
+#ifndef traceLOW_POWER_IDLE_BEGIN
+	#define traceLOW_POWER_IDLE_BEGIN()
+#endif
+
+#ifndef traceLOW_POWER_IDLE_END
+	#define traceLOW_POWER_IDLE_END()
+#endif
+
 #ifndef traceTIMER_CREATE
 	#define traceTIMER_CREATE( pxNewTimer )
 #endif
@@ -472,10 +563,225 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef tracePEND_FUNC_CALL
+	#define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn )
+#endif
+
+#ifndef tracePEND_FUNC_CALL_FROM_ISR
+	#define tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+	#define traceEVENT_GROUP_CREATE( xEventGroup )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE_FAILED
+	#define traceEVENT_GROUP_CREATE_FAILED()
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_BLOCK
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_END
+	#define traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_END
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS_FROM_ISR
+	#define traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+	#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_DELETE
+	#define traceEVENT_GROUP_DELETE( xEventGroup )
+#endif
+
+#ifndef traceMALLOC
+	/* Called when pvPortMalloc() returns, pvAddress is NULL if the allocation
+	failed.  uiSize is the number of bytes taken from the heap. */
+	#define traceMALLOC( pvAddress, uiSize )
+#endif
+
+#ifndef traceFREE
+	/* Called when vPortFree() releases a block of uiSize bytes, or 0 if the
+	heap does not know the size. */
+	#define traceFREE( pvAddress, uiSize )
+#endif
+
+#ifndef traceCRITICAL_ENTER
+	/* Called by the port on entry to a critical section, with interrupts
+	masked and the nesting count incremented to uxNesting. */
+	#define traceCRITICAL_ENTER( uxNesting )
+#endif
+
+#ifndef traceCRITICAL_EXIT
+	/* Called by the port on exit from a critical section, with the nesting
+	count decremented to uxNesting and interrupts still masked. */
+	#define traceCRITICAL_EXIT( uxNesting )
+#endif
+
+#ifndef traceSUSPEND_ALL
+	/* Called by vTaskSuspendAll() once uxSchedulerSuspended has been
+	incremented to uxNesting. */
+	#define traceSUSPEND_ALL( uxNesting )
+#endif
+
+#ifndef traceRESUME_ALL
+	/* Called by xTaskResumeAll() once uxSchedulerSuspended has been
+	decremented to uxNesting, inside a critical section. */
+	#define traceRESUME_ALL( uxNesting )
+#endif
+
+#ifndef traceTICK_ENTER
+	/* Called first thing in the tick interrupt, before traceISR_ENTER() and
+	before the tick count is incremented. */
+	#define traceTICK_ENTER()
+#endif
+
+#ifndef traceISR_ENTER
+	/* Called on entry to the tick interrupt and to any application interrupt
+	handler that wants to appear in the trace. */
+	#define traceISR_ENTER()
+#endif
+
+#ifndef traceISR_EXIT
+	/* Called on exit from an interrupt that called traceISR_ENTER(). */
+	#define traceISR_EXIT()
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 0
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+	#error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+	#define configPRE_SLEEP_PROCESSING( xExpectedIdleTime )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+	#define configPOST_SLEEP_PROCESSING( xExpectedIdleTime )
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH
+	#define configUSE_QUEUE_BATCH 0
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+	#define configUSE_QUEUE_SETS 0
+#endif
+
+#ifndef configUSE_EVENT_GROUPS
+	#define configUSE_EVENT_GROUPS 0
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFERS
+	#define configUSE_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_MAILBOXES
+	#define configUSE_MAILBOXES 0
+#endif
+
+#ifndef configUSE_FAST_MUTEXES
+	#define configUSE_FAST_MUTEXES 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 ) && !defined( configEDF_PRIORITY )
+	#error configUSE_EDF_SCHEDULING needs configEDF_PRIORITY, the priority whose tasks are scheduled by deadline
+#endif
+
+#ifndef configUSE_DEFERRED_CALLS
+	#define configUSE_DEFERRED_CALLS 0
+#endif
+
+#if ( configUSE_DEFERRED_CALLS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_DEFERRED_CALLS requires configUSE_TASK_NOTIFICATIONS to wake the daemon task
+#endif
+
+#ifndef configDEFERRED_TASK_PRIORITY
+	#define configDEFERRED_TASK_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configDEFERRED_TASK_STACK_DEPTH
+	#define configDEFERRED_TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configDEFERRED_QUEUE_LENGTH
+	#define configDEFERRED_QUEUE_LENGTH 16
+#endif
+
+/* Read when a function is pended and again when the daemon calls it, the
+difference is reported as its latency.  Without a clock latencies read 0. */
+#ifndef configDEFERRED_TIMESTAMP
+	#define configDEFERRED_TIMESTAMP() ( 0UL )
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configUSE_SLAB_ALLOCATOR
+	#define configUSE_SLAB_ALLOCATOR 0
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#ifndef configUSE_HEAP_INSTRUMENTATION
+	#define configUSE_HEAP_INSTRUMENTATION 0
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -514,5 +820,86 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define vPortFreeAligned( pvBlockToFree ) vPortFree( pvBlockToFree )
 #endif
 
+/*
+ * Storage for kernel objects supplied by the application instead of the heap,
+ * see xTaskCreateStatic() and xQueueCreateStatic().  The members only mirror
+ * the private structures in tasks.c and queue.c so that each has the same
+ * size as what it stands for, which those files check when they are compiled.
+ * They must not be accessed.
+ */
+typedef struct xSTATIC_LIST_ITEM
+{
+	portTickType xDummy1;
+	void *pvDummy2[ 4 ];
+} xStaticListItem;
+
+typedef struct xSTATIC_LIST
+{
+	unsigned portBASE_TYPE uxDummy1;
+	void *pvDummy2;
+	portTickType xDummy3;
+	void *pvDummy4[ 2 ];
+} xStaticList;
+
+typedef struct xSTATIC_TCB
+{
+	void				*pxDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS	xDummy2;
+	#endif
+	xStaticListItem		xDummy3[ 2 ];
+	unsigned portBASE_TYPE uxDummy4;
+	void				*pxDummy5;
+	signed char			ucDummy6[ configMAX_TASK_NAME_LEN ];
+	#if ( portSTACK_GROWTH > 0 )
+		void			*pxDummy7;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		unsigned portBASE_TYPE uxDummy8;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned portBASE_TYPE uxDummy9[ 2 ];
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxDummy10;
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		void			*pxDummy11;
+	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		unsigned long	ulDummy12;
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		unsigned long	ulDummy13;
+		int				eDummy14;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char	ucDummy15;
+	#endif
+	#if ( INCLUDE_vTaskWalkStacks == 1 )
+		unsigned short	usDummy16;
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		void			*pvDummy17;
+	#endif
+} xStaticTask;
+
+typedef struct xSTATIC_QUEUE
+{
+	void *pvDummy1[ 4 ];
+	xStaticList xDummy2[ 2 ];
+	unsigned portBASE_TYPE uxDummy3[ 3 ];
+	signed portBASE_TYPE xDummy4[ 2 ];
+	#if ( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy5;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned char ucDummy6[ 2 ];
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy7;
+	#endif
+} xStaticQueue;
+
 #endif /* INC_FREERTOS_H */
 
@@ -0,0 +1,190 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef DEFERRED_H
+#define DEFERRED_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include deferred.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/*
+ * Deferred interrupt processing.  An interrupt handler does only what must be
+ * done with the hardware, then passes the rest of the work to the deferred
+ * daemon task with xPendFunctionCallFromISR().  The daemon calls the pended
+ * functions in the order they were pended, in a task context where any API
+ * function may be used and at configDEFERRED_TASK_PRIORITY, by default above
+ * every other task.
+ *
+ * The calls wait in a ring of configDEFERRED_QUEUE_LENGTH slots, a power of
+ * two.  Interrupts claim a slot with one compare-and-swap on the head index
+ * (portCOMPARE_AND_SWAP(), LDREX/STREX on the Cortex-M3) and publish it by
+ * advancing the slot's sequence number, so pending a call takes no critical
+ * section and an interrupt of any priority may nest inside another's.  The
+ * daemon is only notified when the ring was empty; while it is draining the
+ * ring it finds later calls itself.  Ports without a compare-and-swap claim
+ * the slot with interrupts masked instead.
+ *
+ * Unlike xTimerPendFunctionCallFromISR() this neither goes through a queue
+ * nor shares the daemon with timer callbacks.  configUSE_DEFERRED_CALLS and
+ * configUSE_TASK_NOTIFICATIONS must be set to 1 for it to be available.
+ */
+
+/* Define the prototype of the functions pended with
+xPendFunctionCallFromISR(), the same as that of tmrPENDED_FUNCTION. */
+typedef void (*deferredPENDED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
+/*
+ * Counters kept by the daemon, see vDeferredGetStats().  Latencies are in
+ * configDEFERRED_TIMESTAMP() units, measured from the call to
+ * xPendFunctionCallFromISR() to the start of the pended function.
+ *
+ * \defgroup xDeferredStats xDeferredStats
+ * \ingroup Deferred
+ */
+typedef struct xDEFERRED_STATS
+{
+	unsigned long ulCalls;					/*< Pended functions called. */
+	unsigned long ulOverflows;				/*< Calls refused because the ring was full. */
+	unsigned portBASE_TYPE uxHighWaterMark;	/*< Most calls waiting at once. */
+	unsigned long ulLatencyTotal;
+	unsigned long ulLatencyMax;
+} xDeferredStats;
+
+/**
+ * deferred.h
+ * <PRE>portBASE_TYPE xPendFunctionCallFromISR( deferredPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * Have the deferred daemon task call xFunctionToPend( pvParameter1,
+ * ulParameter2 ).  For use from interrupts at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY only.
+ *
+ * @param xFunctionToPend The function to call from the daemon task.
+ *
+ * @param pvParameter1 The first parameter passed to the function.
+ *
+ * @param ulParameter2 The second parameter passed to the function.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the daemon task was
+ * unblocked and has a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the call was pended, pdFAIL if the ring was full.
+ *
+ * Example usage:
+   <pre>
+ static void vProcessByte( void *pvDevice, unsigned long ulByte )
+ {
+	// Runs in the daemon task, may block, give semaphores, and so on.
+ }
+
+ void vUARTInterruptHandler( void )
+ {
+ signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+ unsigned long ulByte;
+
+	ulByte = ulReadDataRegister();
+	xPendFunctionCallFromISR( vProcessByte, NULL, ulByte, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ }
+   </pre>
+ * \defgroup xPendFunctionCallFromISR xPendFunctionCallFromISR
+ * \ingroup Deferred
+ */
+portBASE_TYPE xPendFunctionCallFromISR( deferredPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred.h
+ * <PRE>void vDeferredGetStats( xDeferredStats *pxStats, portBASE_TYPE xReset );</PRE>
+ *
+ * Copy the daemon's counters to *pxStats, then zero them if xReset is not
+ * pdFALSE.
+ *
+ * \defgroup vDeferredGetStats vDeferredGetStats
+ * \ingroup Deferred
+ */
+void vDeferredGetStats( xDeferredStats *pxStats, portBASE_TYPE xReset ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+portBASE_TYPE xDeferredCreateDaemonTask( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DEFERRED_H */
+
@@ -0,0 +1,354 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include event_groups.h"
+#endif
+
+#include "timers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/*
+ * An event group is a set of event bits.  Tasks wait for any or all of a
+ * combination of bits to be set, and one call that sets bits unblocks every
+ * task whose condition it satisfies, in a single pass over the tasks waiting
+ * on the group.  That makes event groups suited to broadcasting an event to
+ * several tasks, or to synchronising several tasks at a barrier with
+ * xEventGroupSync().
+ *
+ * The number of bits an event group holds depends on configUSE_16_BIT_TICKS.
+ * With 32 bit ticks it holds 24 bits, with 16 bit ticks 8 bits; the top byte
+ * is reserved for the kernel.
+ *
+ * Setting bits walks a list of tasks of unbounded length, which is not allowed
+ * in an interrupt.  The FromISR functions therefore defer the operation to the
+ * deferred daemon task with xPendFunctionCallFromISR() if configUSE_DEFERRED_CALLS
+ * is set to 1, see deferred.h.  Otherwise they defer it to the timer service
+ * task with xTimerPendFunctionCallFromISR(), and require configUSE_TIMERS and
+ * INCLUDE_xTimerPendFunctionCall to be set to 1.
+ * configUSE_EVENT_GROUPS must be set to 1 for any of this to be available.
+ */
+
+/**
+ * Type by which event groups are referenced.  For example, a call to
+ * xEventGroupCreate() returns an xEventGroupHandle variable that can then be
+ * used as a parameter to other event group functions.
+ *
+ * \defgroup xEventGroupHandle xEventGroupHandle
+ * \ingroup EventGroup
+ */
+typedef void * xEventGroupHandle;
+
+/*
+ * The type that holds event bits always matches portTickType, so it is 16
+ * bits wide with configUSE_16_BIT_TICKS set to 1, and 32 bits wide otherwise.
+ *
+ * \defgroup xEventBits xEventBits
+ * \ingroup EventGroup
+ */
+typedef portTickType xEventBits;
+
+/**
+ * event_groups.h
+ * <PRE>xEventGroupHandle xEventGroupCreate( void );</PRE>
+ *
+ * Create a new event group with all its bits clear.
+ *
+ * @return If the event group was created then a handle to it is returned.
+ * If there was insufficient FreeRTOS heap available to create the event
+ * group then NULL is returned.
+ *
+ * \defgroup xEventGroupCreate xEventGroupCreate
+ * \ingroup EventGroup
+ */
+xEventGroupHandle xEventGroupCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup,
+                                 const xEventBits uxBitsToWaitFor,
+                                 const portBASE_TYPE xClearOnExit,
+                                 const portBASE_TYPE xWaitForAllBits,
+                                 portTickType xTicksToWait );</PRE>
+ *
+ * Read bits within an event group, optionally entering the Blocked state
+ * (with a timeout) to wait for a bit or group of bits to become set.
+ *
+ * This function cannot be called from an interrupt.
+ *
+ * @param xEventGroup The event group in which the bits are being tested.
+ *
+ * @param uxBitsToWaitFor A bitwise value that indicates the bit or bits to
+ * test inside the event group.  Must not be 0.
+ *
+ * @param xClearOnExit If pdTRUE then any bits within uxBitsToWaitFor that
+ * are set within the event group are cleared before the function returns, if
+ * the wait condition was met.  A timeout leaves the bits unchanged.
+ *
+ * @param xWaitForAllBits If pdTRUE the function returns when all the bits in
+ * uxBitsToWaitFor are set, if pdFALSE when any of them is set.  Either way
+ * it also returns when the block time expires.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the condition to be met.
+ *
+ * @return The value of the event group at the time either the bits being
+ * waited for became set, or the block time expired, before any bits were
+ * cleared by xClearOnExit.  Test the return value to know which happened.
+ *
+ * Example usage:
+   <pre>
+   #define BIT_0	( 1 << 0 )
+   #define BIT_4	( 1 << 4 )
+
+   void aFunction( xEventGroupHandle xEventGroup )
+   {
+   xEventBits uxBits;
+
+		// Wait a maximum of 100ms for either bit 0 or bit 4 to be set within
+		// the event group.  Clear the bits before exiting.
+		uxBits = xEventGroupWaitBits( xEventGroup, BIT_0 | BIT_4, pdTRUE, pdFALSE, 100 / portTICK_RATE_MS );
+
+		if( ( uxBits & ( BIT_0 | BIT_4 ) ) != 0 )
+		{
+			// At least one of the bits was set.
+		}
+		else
+		{
+			// The timeout expired.
+		}
+   }
+   </pre>
+ * \defgroup xEventGroupWaitBits xEventGroupWaitBits
+ * \ingroup EventGroup
+ */
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToWaitFor, const portBASE_TYPE xClearOnExit, const portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear );</PRE>
+ *
+ * Clear bits within an event group.  This function cannot be called from an
+ * interrupt, see xEventGroupClearBitsFromISR().
+ *
+ * @param uxBitsToClear A bitwise value that indicates the bit or bits to
+ * clear.
+ *
+ * @return The value of the event group before the bits were cleared.
+ *
+ * \defgroup xEventGroupClearBits xEventGroupClearBits
+ * \ingroup EventGroup
+ */
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet );</PRE>
+ *
+ * Set bits within an event group, unblocking every task whose wait condition
+ * is met as a result.  This function cannot be called from an interrupt, see
+ * xEventGroupSetBitsFromISR().
+ *
+ * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
+ *
+ * @return The value of the event group at the time the call returns.  That
+ * may not include the bits just set, if an unblocked task cleared them on
+ * exit.
+ *
+ * \defgroup xEventGroupSetBits xEventGroupSetBits
+ * \ingroup EventGroup
+ */
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupSync( xEventGroupHandle xEventGroup,
+                             const xEventBits uxBitsToSet,
+                             const xEventBits uxBitsToWaitFor,
+                             portTickType xTicksToWait );</PRE>
+ *
+ * Atomically set bits within an event group, then wait for a combination of
+ * bits to be set.  Typically each task taking part in a rendezvous sets its
+ * own bit and waits for the bits of all the others.  The bits waited for
+ * are cleared automatically once every task has arrived.
+ *
+ * This function cannot be called from an interrupt.
+ *
+ * @param uxBitsToSet The bits to set before waiting.
+ *
+ * @param uxBitsToWaitFor The bits that must all be set before the function
+ * returns.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for all the bits to become set.
+ *
+ * @return The value of the event group at the time either the bits being
+ * waited for became set, or the block time expired.  If all the bits in
+ * uxBitsToWaitFor are set the rendezvous succeeded.
+ *
+ * \defgroup xEventGroupSync xEventGroupSync
+ * \ingroup EventGroup
+ */
+xEventBits xEventGroupSync( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, const xEventBits uxBitsToWaitFor, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupGetBits( xEventGroupHandle xEventGroup );</PRE>
+ *
+ * Returns the current value of the bits in an event group.  This function
+ * cannot be used from an interrupt, see xEventGroupGetBitsFromISR().
+ *
+ * \defgroup xEventGroupGetBits xEventGroupGetBits
+ * \ingroup EventGroup
+ */
+#define xEventGroupGetBits( xEventGroup ) xEventGroupClearBits( xEventGroup, 0 )
+
+/**
+ * event_groups.h
+ * <PRE>xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup );</PRE>
+ *
+ * A version of xEventGroupGetBits() that can be called from an interrupt.
+ *
+ * \defgroup xEventGroupGetBitsFromISR xEventGroupGetBitsFromISR
+ * \ingroup EventGroup
+ */
+xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>void vEventGroupDelete( xEventGroupHandle xEventGroup );</PRE>
+ *
+ * Delete an event group.  Tasks blocked on the event group are unblocked and
+ * see an event group value of 0.
+ *
+ * \defgroup vEventGroupDelete vEventGroupDelete
+ * \ingroup EventGroup
+ */
+void vEventGroupDelete( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_DEFERRED_CALLS == 1 ) || ( ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) )
+
+/**
+ * event_groups.h
+ * <PRE>portBASE_TYPE xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xEventGroupSetBits() that can be called from an interrupt.
+ *
+ * The bits are not set immediately.  The operation is sent to the deferred
+ * daemon or the timer service task, see above, which sets them when it next
+ * runs, so a task unblocked by the bits runs after that task whatever its
+ * priority.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the operation
+ * unblocked the deferring task and that task has a priority above the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt exits.
+ *
+ * @return pdPASS if the operation was sent, pdFAIL if the deferred call ring
+ * or the timer command queue was full.
+ *
+ * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
+ * \ingroup EventGroup
+ */
+portBASE_TYPE xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * <PRE>portBASE_TYPE xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xEventGroupClearBits() that can be called from an interrupt.
+ * The operation is deferred exactly as with xEventGroupSetBitsFromISR().
+ *
+ * @return pdPASS if the operation was sent, pdFAIL if the deferred call ring
+ * or the timer command queue was full.
+ *
+ * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
+ * \ingroup EventGroup
+ */
+portBASE_TYPE xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DEFERRED_CALLS, or configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall */
+
+/* For internal use only, the functions pended by the FromISR variants. */
+void vEventGroupSetBitsCallback( void *pvEventGroup, unsigned long ulBitsToSet ) PRIVILEGED_FUNCTION;
+void vEventGroupClearBitsCallback( void *pvEventGroup, unsigned long ulBitsToClear ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EVENT_GROUPS_H */
+
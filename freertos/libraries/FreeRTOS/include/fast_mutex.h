@@ -0,0 +1,185 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef FAST_MUTEX_H
+#define FAST_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include fast_mutex.h"
+#endif
+
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/*
+ * A fast mutex is a mutex whose uncontended take and give are a single
+ * compare-and-swap on the owner word, with no critical section and no queue.
+ * The port supplies the compare-and-swap as portCOMPARE_AND_SWAP(), built on
+ * LDREX/STREX on the Cortex-M3; ports without it fall back to a critical
+ * section around a plain compare and store.
+ *
+ * Only when a task finds the mutex held does it take the kernel path: it
+ * marks the owner word contended, lends its priority to the holder as a
+ * standard mutex does, and blocks.  A give that finds the mark hands the
+ * mutex directly to the highest priority waiter and drops any inherited
+ * priority.
+ *
+ * Fast mutexes are not recursive and cannot be used from interrupts.  The
+ * structure is allocated by the application, statically or otherwise, and
+ * set up with vFastMutexInitialise().  configUSE_FAST_MUTEXES and
+ * configUSE_MUTEXES must be set to 1 for them to be available.
+ */
+
+/*
+ * Not to be accessed directly, declared here so the application can allocate
+ * it.  ulOwner is 0 when the mutex is free, else the handle of the holding
+ * task with bit 0 set if other tasks may be waiting for it.
+ *
+ * \defgroup xFastMutex xFastMutex
+ * \ingroup FastMutex
+ */
+typedef struct xFAST_MUTEX
+{
+	volatile unsigned long ulOwner;
+	xList xTasksWaiting;			/*< Tasks blocked on the mutex, in priority order. */
+	unsigned long ulContentions;	/*< Takes that found the mutex held. */
+} xFastMutex;
+
+/**
+ * fast_mutex.h
+ * <PRE>void vFastMutexInitialise( xFastMutex *pxMutex );</PRE>
+ *
+ * Set up a fast mutex in the free state.  It needs no kernel resources, so it
+ * may be called before the scheduler starts, from a constructor for example.
+ *
+ * \defgroup vFastMutexInitialise vFastMutexInitialise
+ * \ingroup FastMutex
+ */
+void vFastMutexInitialise( xFastMutex *pxMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ * <PRE>portBASE_TYPE xFastMutexTake( xFastMutex *pxMutex, portTickType xTicksToWait );</PRE>
+ *
+ * Take a fast mutex, blocking for up to xTicksToWait ticks while another task
+ * holds it.  The holder inherits the priority of the caller for as long as
+ * the caller waits.
+ *
+ * @param pxMutex The mutex to take.
+ *
+ * @param xTicksToWait The maximum time to block.  portMAX_DELAY blocks
+ * indefinitely if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return pdPASS if the mutex was taken, pdFAIL if the block time expired.
+ *
+ * Example usage:
+   <pre>
+ static xFastMutex xLock;
+
+ void vTask( void *pvParameters )
+ {
+	for( ;; )
+	{
+		if( xFastMutexTake( &xLock, portMAX_DELAY ) == pdPASS )
+		{
+			// Use the resource the mutex guards.
+			xFastMutexGive( &xLock );
+		}
+	}
+ }
+   </pre>
+ * \defgroup xFastMutexTake xFastMutexTake
+ * \ingroup FastMutex
+ */
+portBASE_TYPE xFastMutexTake( xFastMutex *pxMutex, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ * <PRE>portBASE_TYPE xFastMutexGive( xFastMutex *pxMutex );</PRE>
+ *
+ * Give back a fast mutex taken by the calling task.
+ *
+ * @return pdPASS if the mutex was given, pdFAIL if the calling task did not
+ * hold it.
+ *
+ * \defgroup xFastMutexGive xFastMutexGive
+ * \ingroup FastMutex
+ */
+portBASE_TYPE xFastMutexGive( xFastMutex *pxMutex ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* FAST_MUTEX_H */
+
@@ -0,0 +1,294 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include mailbox.h"
+#endif
+
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/*
+ * Mailboxes pass buffers by reference.  Buffers come from a pool of fixed
+ * size buffers allocated when the pool is created.  A task borrows a buffer
+ * from its pool, fills it in place and posts it to a mailbox, which hands
+ * ownership to the task that fetches it.  That task reads it in place and
+ * returns it to its pool.  Only the pointer is copied through the mailbox,
+ * whatever the size of the buffer.
+ *
+ * Each buffer records whether it is free, held by a task or waiting in a
+ * mailbox, and configASSERT() catches a buffer returned twice or posted by a
+ * task that does not hold it.  configUSE_MAILBOXES must be set to 1 for any
+ * of this to be available.
+ */
+
+/**
+ * Types by which mailbox pools and mailboxes are referenced.
+ */
+typedef void * xMailboxPoolHandle;
+typedef xQueueHandle xMailboxHandle;
+
+/* The prototype of a release callback, see xMailboxPoolCreate(). */
+typedef void (*mbRELEASE_CALLBACK)( void *pvBuffer );
+
+/**
+ * mailbox. h
+ * <PRE>xMailboxPoolHandle xMailboxPoolCreate( unsigned portBASE_TYPE uxBufferCount, size_t xBufferSize, mbRELEASE_CALLBACK pxReleaseCallback );</PRE>
+ *
+ * Creates a pool of uxBufferCount buffers of xBufferSize bytes each, all
+ * allocated from the FreeRTOS heap in one block.
+ *
+ * @param pxReleaseCallback Called with each buffer as it is returned to the
+ * pool, before any other task can borrow it, or NULL.  It runs in the task or
+ * interrupt that returns the buffer so must be short, and must not block if
+ * buffers are returned from interrupts.
+ *
+ * @return The handle of the new pool, or NULL if there was not enough heap.
+ *
+ * \page xMailboxPoolCreate xMailboxPoolCreate
+ * \ingroup Mailboxes
+ */
+xMailboxPoolHandle xMailboxPoolCreate( unsigned portBASE_TYPE uxBufferCount, size_t xBufferSize, mbRELEASE_CALLBACK pxReleaseCallback ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void vMailboxPoolDelete( xMailboxPoolHandle xPool );</PRE>
+ *
+ * Frees a pool and its buffers.  Every buffer must have been returned to the
+ * pool first.
+ *
+ * \page vMailboxPoolDelete vMailboxPoolDelete
+ * \ingroup Mailboxes
+ */
+void vMailboxPoolDelete( xMailboxPoolHandle xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void *pvMailboxBorrow( xMailboxPoolHandle xPool, portTickType xTicksToWait );</PRE>
+ *
+ * Takes a free buffer from a pool.  The calling task holds the buffer until
+ * it posts it to a mailbox or returns it with vMailboxReturn().
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * buffer to be returned if none is free.
+ *
+ * @return The buffer, or NULL if none became free in time.
+ *
+ * \page pvMailboxBorrow pvMailboxBorrow
+ * \ingroup Mailboxes
+ */
+void *pvMailboxBorrow( xMailboxPoolHandle xPool, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void vMailboxReturn( void *pvBuffer );</PRE>
+ *
+ * Gives a buffer held by the calling task back to the pool it came from,
+ * after calling the release callback of the pool if it has one.
+ *
+ * \page vMailboxReturn vMailboxReturn
+ * \ingroup Mailboxes
+ */
+void vMailboxReturn( void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void vMailboxReturnFromISR( void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of vMailboxReturn() that can be used from an interrupt service
+ * routine.
+ *
+ * \page vMailboxReturnFromISR vMailboxReturnFromISR
+ * \ingroup Mailboxes
+ */
+void vMailboxReturnFromISR( void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>size_t xMailboxBufferSize( void *pvBuffer );</PRE>
+ *
+ * @return The size of the buffers of the pool pvBuffer belongs to.
+ *
+ * \page xMailboxBufferSize xMailboxBufferSize
+ * \ingroup Mailboxes
+ */
+size_t xMailboxBufferSize( void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>xMailboxHandle xMailboxCreate( unsigned portBASE_TYPE uxLength );</PRE>
+ *
+ * Creates a mailbox able to hold uxLength buffers, from any pools.
+ *
+ * @return The handle of the new mailbox, or NULL if there was not enough
+ * heap.
+ *
+ * \page xMailboxCreate xMailboxCreate
+ * \ingroup Mailboxes
+ */
+#define xMailboxCreate( uxLength ) xQueueCreate( ( uxLength ), sizeof( void * ) )
+
+/**
+ * mailbox. h
+ * <PRE>void vMailboxDelete( xMailboxHandle xMailbox );</PRE>
+ *
+ * Deletes a mailbox.  Buffers still in it are not returned to their pools.
+ *
+ * \page vMailboxDelete vMailboxDelete
+ * \ingroup Mailboxes
+ */
+#define vMailboxDelete( xMailbox ) vQueueDelete( xMailbox )
+
+/**
+ * mailbox. h
+ * <PRE>portBASE_TYPE xMailboxPost( xMailboxHandle xMailbox, void *pvBuffer, portTickType xTicksToWait );</PRE>
+ *
+ * Posts a buffer held by the calling task to a mailbox.  Once posted the
+ * buffer belongs to whichever task fetches it, the caller must not touch it
+ * again.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for room
+ * in the mailbox.
+ *
+ * @return pdPASS if the buffer was posted.  Otherwise errQUEUE_FULL, and the
+ * caller still holds the buffer.
+ *
+ * \page xMailboxPost xMailboxPost
+ * \ingroup Mailboxes
+ */
+portBASE_TYPE xMailboxPost( xMailboxHandle xMailbox, void *pvBuffer, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>portBASE_TYPE xMailboxPostFromISR( xMailboxHandle xMailbox, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xMailboxPost() that can be used from an interrupt service
+ * routine, for a buffer the interrupt borrowed with pvMailboxBorrowFromISR().
+ *
+ * \page xMailboxPostFromISR xMailboxPostFromISR
+ * \ingroup Mailboxes
+ */
+portBASE_TYPE xMailboxPostFromISR( xMailboxHandle xMailbox, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void *pvMailboxBorrowFromISR( xMailboxPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of pvMailboxBorrow() that can be used from an interrupt service
+ * routine.
+ *
+ * @return A free buffer, or NULL if there is none.
+ *
+ * \page pvMailboxBorrowFromISR pvMailboxBorrowFromISR
+ * \ingroup Mailboxes
+ */
+void *pvMailboxBorrowFromISR( xMailboxPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void *pvMailboxFetch( xMailboxHandle xMailbox, portTickType xTicksToWait );</PRE>
+ *
+ * Takes the oldest buffer from a mailbox.  The calling task then holds it
+ * until it returns it with vMailboxReturn() or posts it on.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * buffer to be posted.
+ *
+ * @return The buffer, or NULL if none was posted in time.
+ *
+ * \page pvMailboxFetch pvMailboxFetch
+ * \ingroup Mailboxes
+ */
+void *pvMailboxFetch( xMailboxHandle xMailbox, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox. h
+ * <PRE>void *pvMailboxFetchFromISR( xMailboxHandle xMailbox, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of pvMailboxFetch() that can be used from an interrupt service
+ * routine.
+ *
+ * \page pvMailboxFetchFromISR pvMailboxFetchFromISR
+ * \ingroup Mailboxes
+ */
+void *pvMailboxFetchFromISR( xMailboxHandle xMailbox, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* MAILBOX_H */
+
@@ -0,0 +1,184 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef MESSAGE_BUFFER_H
+#define MESSAGE_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include message_buffer.h"
+#endif
+
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A message buffer is a stream buffer that keeps the boundaries between
+ * writes.  Each message is stored after its length, a size_t, so a 10 byte
+ * message takes 14 bytes of the buffer, and a read returns exactly one whole
+ * message.  The same single writer and single reader rules as for stream
+ * buffers apply, see stream_buffer.h.
+ */
+
+/**
+ * Type by which message buffers are referenced.
+ */
+typedef xStreamBufferHandle xMessageBufferHandle;
+
+/**
+ * message_buffer. h
+ * <PRE>xMessageBufferHandle xMessageBufferCreate( size_t xBufferSizeBytes );</PRE>
+ *
+ * Creates a new message buffer able to hold xBufferSizeBytes bytes, lengths
+ * included.
+ *
+ * @return The handle of the new message buffer, or NULL if there was not
+ * enough heap.
+ *
+ * \page xMessageBufferCreate xMessageBufferCreate
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreate( xBufferSizeBytes ) ( xMessageBufferHandle ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+
+/**
+ * message_buffer. h
+ * <PRE>size_t xMessageBufferSend( xMessageBufferHandle xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );</PRE>
+ *
+ * Writes one message.  Either the whole message is written or, if there is
+ * still not enough space when xTicksToWait expires, nothing is.  An empty
+ * message is not stored.
+ *
+ * @return xDataLengthBytes if the message was written, otherwise 0.
+ *
+ * \page xMessageBufferSend xMessageBufferSend
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSend( ( xStreamBufferHandle ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer. h
+ * <PRE>size_t xMessageBufferSendFromISR( xMessageBufferHandle xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xMessageBufferSend() that can be used from an interrupt
+ * service routine, see xStreamBufferSendFromISR().
+ *
+ * \page xMessageBufferSendFromISR xMessageBufferSendFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( xStreamBufferHandle ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer. h
+ * <PRE>size_t xMessageBufferReceive( xMessageBufferHandle xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );</PRE>
+ *
+ * Reads the next message.  If it is longer than xBufferLengthBytes it is left
+ * in the buffer and 0 is returned.
+ *
+ * @return The length of the message read, 0 if the call timed out or the
+ * message did not fit.
+ *
+ * \page xMessageBufferReceive xMessageBufferReceive
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( xStreamBufferHandle ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer. h
+ * <PRE>size_t xMessageBufferReceiveFromISR( xMessageBufferHandle xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xMessageBufferReceive() that can be used from an interrupt
+ * service routine, see xStreamBufferReceiveFromISR().
+ *
+ * \page xMessageBufferReceiveFromISR xMessageBufferReceiveFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( xStreamBufferHandle ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer. h
+ * <PRE>size_t xMessageBufferNextLengthBytes( xMessageBufferHandle xMessageBuffer );</PRE>
+ *
+ * @return The length of the next message, 0 if the buffer is empty.
+ *
+ * \page xMessageBufferNextLengthBytes xMessageBufferNextLengthBytes
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferNextLengthBytes( xMessageBuffer ) xStreamBufferNextMessageLengthBytes( ( xStreamBufferHandle ) ( xMessageBuffer ) )
+
+#define vMessageBufferDelete( xMessageBuffer ) vStreamBufferDelete( ( xStreamBufferHandle ) ( xMessageBuffer ) )
+#define xMessageBufferReset( xMessageBuffer ) xStreamBufferReset( ( xStreamBufferHandle ) ( xMessageBuffer ) )
+#define xMessageBufferIsEmpty( xMessageBuffer ) xStreamBufferIsEmpty( ( xStreamBufferHandle ) ( xMessageBuffer ) )
+#define xMessageBufferIsFull( xMessageBuffer ) ( xStreamBufferSpacesAvailable( ( xStreamBufferHandle ) ( xMessageBuffer ) ) <= sizeof( size_t ) )
+#define xMessageBufferSpacesAvailable( xMessageBuffer ) xStreamBufferSpacesAvailable( ( xStreamBufferHandle ) ( xMessageBuffer ) )
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* MESSAGE_BUFFER_H */
+
@@ -362,14 +362,89 @@ extern "C" {
 	portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters );
 #endif
 
+/*
+ * With configUSE_SLAB_ALLOCATOR set, pvPortMalloc() and vPortFree() are the
+ * slab front end in MemMang/slab.c.  Heap implementations define
+ * portHEAP_IMPLEMENTATION so their entry points are renamed to the ones the
+ * front end falls back on.
+ */
+#if( configUSE_SLAB_ALLOCATOR == 1 )
+	void *pvPortHeapMalloc( size_t xSize ) PRIVILEGED_FUNCTION;
+	void vPortHeapFree( void *pv ) PRIVILEGED_FUNCTION;
+	void *pvPortHeapRealloc( void *pv, size_t xSize ) PRIVILEGED_FUNCTION;
+
+	#ifdef portHEAP_IMPLEMENTATION
+		#define pvPortMalloc	pvPortHeapMalloc
+		#define vPortFree		vPortHeapFree
+		#define pvPortRealloc	pvPortHeapRealloc
+
+		/* Allocations are traced once, by the front end, so the call site
+		seen by traceMALLOC() is the real caller. */
+		#undef traceMALLOC
+		#undef traceFREE
+		#define traceMALLOC( pvAddress, uiSize )
+		#define traceFREE( pvAddress, uiSize )
+	#endif
+
+	typedef struct xSLAB_STATS
+	{
+		size_t xBlockSize;						/*< Size of the blocks in this class. */
+		unsigned portBASE_TYPE uxBlocks;		/*< Number of blocks in the pool. */
+		unsigned portBASE_TYPE uxInUse;			/*< Blocks currently allocated. */
+		unsigned portBASE_TYPE uxMaxInUse;		/*< High water mark of uxInUse. */
+		unsigned long ulAllocations;			/*< Requests served from the pool. */
+		unsigned long ulFallbacks;				/*< Requests passed on to the heap because the pool was empty. */
+	} xSlabStats;
+
+	/* Fill in the statistics of size class uxClass.  Returns pdFALSE once
+	uxClass is past the last class. */
+	portBASE_TYPE xPortGetSlabStats( unsigned portBASE_TYPE uxClass, xSlabStats *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
 void *pvPortMalloc( size_t xSize ) PRIVILEGED_FUNCTION;
 void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Resize a block, keeping its contents up to the smaller of the two sizes.
+ * Heaps that can grow a block into the free memory right after it do so
+ * instead of moving it.  On failure NULL is returned and pv is untouched.
+ * A NULL pv allocates, a zero size frees.
+ */
+void *pvPortRealloc( void *pv, size_t xSize ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Bytes the heap manages in total, 0 when the C library owns the memory.
+ */
+size_t xPortGetTotalHeapSize( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * heap_5 only: the memory the heap is built from.  pxHeapRegions is in
+ * ascending address order and ends with a region of size zero.  Must be
+ * called before the first allocation, otherwise the region between .bss and
+ * the main stack defined by the linker script is used.
+ */
+typedef struct HEAP_REGION
+{
+	unsigned char *pucStartAddress;
+	size_t xSizeInBytes;
+} xHeapRegion;
+
+void vPortDefineHeapRegions( const xHeapRegion * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	/*
+	 * Call pxCallback for each free block of the heap.  The scheduler is
+	 * suspended for the whole walk, so the callback must not block.
+	 */
+	typedef void ( *pdHEAP_BLOCK_CALLBACK )( void *pvBlock, size_t xBlockSize, void *pvParameter );
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -86,6 +86,13 @@ extern "C" {
  */
 typedef void * xQueueHandle;
 
+/**
+ * Types by which queue sets, and the queues and semaphores that are members
+ * of a set, are referenced.  See xQueueCreateSet().
+ */
+typedef void * xQueueSetHandle;
+typedef void * xQueueSetMemberHandle;
+
 
 /* For internal use only. */
 #define	queueSEND_TO_BACK	( 0 )
@@ -156,6 +163,53 @@ typedef void * xQueueHandle;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueue *pxQueueBuffer
+						  );
+ * </pre>
+ *
+ * Creates a new queue instance without using the FreeRTOS heap.  The
+ * parameters are as for xQueueCreate(), except that the application supplies
+ * the memory for the queue, typically as static variables, so the queue can
+ * be created whatever the state of the heap.  The memory is left alone if the
+ * queue is deleted.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * @param pucQueueStorage uxQueueLength * uxItemSize bytes for the items, or
+ * NULL if uxItemSize is 0.
+ *
+ * @param pxQueueBuffer Holds the queue structure.
+ *
+ * @return The handle of the queue.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+ #define ITEM_SIZE sizeof( unsigned long )
+
+ static xStaticQueue xQueueBuffer;
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * ITEM_SIZE ];
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, ITEM_SIZE, ucQueueStorage, &xQueueBuffer );
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+
 /**
  * queue. h
  * <pre>
@@ -1197,6 +1251,280 @@ signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue );
 signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue );
 unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue );
 
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueSendMultiple(
+											  xQueueHandle xQueue,
+											  const void * pvItems,
+											  unsigned portBASE_TYPE uxItemCount,
+											  portTickType xTicksToWait
+										  );
+ * </pre>
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 for this function to be available.
+ *
+ * Post uxItemCount items, stored one after the other at pvItems, to the back
+ * of a queue.  As many items as there is space for are copied within one
+ * critical section, in at most two memcpy() calls, and one blocked receiver
+ * is unblocked per item rather than one per call.  If the queue fills up
+ * before all the items are posted the calling task blocks, for at most
+ * xTicksToWait in total, for space for the rest.
+ *
+ * Must not be used on a semaphore or mutex, nor from an interrupt service
+ * routine, see uxQueueSendMultipleFromISR().
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems Pointer to the first of the items to be copied.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return The number of items posted, less than uxItemCount if the block
+ * time expired first.
+ *
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle xQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueSendMultipleFromISR(
+													 xQueueHandle pxQueue,
+													 const void *pvItems,
+													 unsigned portBASE_TYPE uxItemCount,
+													 portBASE_TYPE *pxHigherPriorityTaskWoken
+												 );
+ * </pre>
+ *
+ * A version of uxQueueSendMultiple() that can be used from an interrupt
+ * service routine.  It never blocks, it posts as many of the items as there
+ * is space for.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the currently running task.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueReceiveMultiple(
+												 xQueueHandle xQueue,
+												 void *pvBuffer,
+												 unsigned portBASE_TYPE uxMaxItems,
+												 portTickType xTicksToWait
+											 );
+ * </pre>
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 for this function to be available.
+ *
+ * Receive up to uxMaxItems items from a queue.  The call blocks, for at most
+ * xTicksToWait, until the queue holds at least one item, then copies all
+ * the items there are up to uxMaxItems within one critical section and
+ * unblocks one sender per item removed.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive, at least 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive.
+ *
+ * @return The number of items received, 0 if the block time expired.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR(
+														xQueueHandle pxQueue,
+														void *pvBuffer,
+														unsigned portBASE_TYPE uxMaxItems,
+														portBASE_TYPE *pxTaskWoken
+													);
+ * </pre>
+ *
+ * A version of uxQueueReceiveMultiple() that can be used from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxTaskWoken Set to pdTRUE if removing the items unblocked a task
+ * with a priority higher than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetHandle xQueueCreateSet(
+									unsigned portBASE_TYPE uxEventQueueLength
+								);
+ * </pre>
+ *
+ * configUSE_QUEUE_SETS must be set to 1 for this function and the other
+ * queue set functions to be available.
+ *
+ * A queue set lets a task block on several queues and semaphores at once.
+ * Queues and semaphores are added to the set with xQueueAddToSet().  Each
+ * time an item is posted to a member, or a member semaphore is given, the
+ * handle of the member is posted to the set.  xQueueSelectFromSet() blocks
+ * on the set and returns the handle of a member that holds an item, which
+ * must then be read from that member with a zero block time.
+ *
+ * Every item posted to a member must be read from it once its handle has
+ * been selected, or the set and its members get out of step.  For the same
+ * reason a member must not be read without first being selected, and must
+ * not be reset.  Mutexes cannot be members of a set.
+ *
+ * @param uxEventQueueLength The number of member handles the set can hold.
+ * This must be at least the sum of the lengths of its members, counting 1
+ * for a binary semaphore, so that posting to a member never finds the set
+ * full.
+ *
+ * @return The handle of the new set, or NULL if there was not enough heap.
+ * A set is deleted with vQueueDelete() once its members have been removed.
+ *
+ * \defgroup xQueueCreateSet xQueueCreateSet
+ * \ingroup QueueSets
+ */
+xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueAddToSet(
+								xQueueSetMemberHandle xQueueOrSemaphore,
+								xQueueSetHandle xQueueSet
+							);
+ * </pre>
+ *
+ * Adds a queue or semaphore to a queue set.  A queue or semaphore can be a
+ * member of one set at most, and can only be added while it is empty; a
+ * binary semaphore created with vSemaphoreCreateBinary() must be taken
+ * first.
+ *
+ * @return pdPASS if the queue or semaphore was added.  pdFAIL if it is
+ * already a member of a set, is not empty or is a mutex.
+ *
+ * \defgroup xQueueAddToSet xQueueAddToSet
+ * \ingroup QueueSets
+ */
+portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueRemoveFromSet(
+									xQueueSetMemberHandle xQueueOrSemaphore,
+									xQueueSetHandle xQueueSet
+								);
+ * </pre>
+ *
+ * Removes a queue or semaphore from a queue set.  Like xQueueAddToSet(), it
+ * only succeeds while the queue or semaphore is empty, so that the set holds
+ * no handles for it.
+ *
+ * @return pdPASS if the queue or semaphore was removed.  pdFAIL if it is not
+ * a member of xQueueSet or is not empty.
+ *
+ * \defgroup xQueueRemoveFromSet xQueueRemoveFromSet
+ * \ingroup QueueSets
+ */
+portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSet(
+											xQueueSetHandle xQueueSet,
+											portTickType xTicksToWait
+										);
+ * </pre>
+ *
+ * Blocks until a member of a queue set holds an item, or a member semaphore
+ * is available.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a member to become ready.
+ *
+ * @return The handle of a member that is ready, in the order the members
+ * became ready, or NULL if the block time expired.  One item must be read
+ * from, or the semaphore taken, with a zero block time.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( xQueueHandle xQueue, xSemaphoreHandle xSemaphore )
+ {
+ xQueueSetHandle xSet;
+ xQueueSetMemberHandle xReady;
+ char cItem;
+
+	// The queue holds 10 items and the semaphore 1, the set needs room
+	// for a handle for each of them.
+	xSet = xQueueCreateSet( 10 + 1 );
+	xQueueAddToSet( xQueue, xSet );
+	xQueueAddToSet( xSemaphore, xSet );
+
+	for( ;; )
+	{
+		xReady = xQueueSelectFromSet( xSet, portMAX_DELAY );
+		if( xReady == xQueue )
+		{
+			xQueueReceive( xQueue, &cItem, 0 );
+		}
+		else if( xReady == xSemaphore )
+		{
+			xSemaphoreTake( xSemaphore, 0 );
+		}
+	}
+ }
+   </pre>
+ *
+ * \defgroup xQueueSelectFromSet xQueueSelectFromSet
+ * \ingroup QueueSets
+ */
+xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSetFromISR(
+													xQueueSetHandle xQueueSet
+												);
+ * </pre>
+ *
+ * A version of xQueueSelectFromSet() that can be used from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @return The handle of a member that is ready, or NULL if there is none.
+ *
+ * \defgroup xQueueSelectFromSetFromISR xQueueSelectFromSetFromISR
+ * \ingroup QueueSets
+ */
+xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+
 
 /*
  * xQueueAltGenericSend() is an alternative version of xQueueGenericSend().
@@ -1239,6 +1567,7 @@ signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, port
  * these functions directly.
  */
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType );
+xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue );
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
 void* xQueueGetMutexHolder( xQueueHandle xSemaphore );
 
@@ -1286,6 +1615,7 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
  * any queue, semaphore or mutex creation function or macro.
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType );
+xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType );
 
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait );
@@ -75,6 +75,10 @@
 
 typedef xQueueHandle xSemaphoreHandle;
 
+/* Storage for a semaphore or mutex supplied by the application, see
+xSemaphoreCreateMutexStatic(). */
+typedef xStaticQueue xStaticSemaphore;
+
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1U )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0U )
 #define semGIVE_BLOCK_TIME					( ( portTickType ) 0U )
@@ -601,6 +605,37 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * <i>Macro</i> that creates a mutex exactly as xSemaphoreCreateMutex() does,
+ * but in memory supplied by the application instead of the FreeRTOS heap.
+ * The memory is left alone if the mutex is deleted.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * @param pxMutexBuffer Holds the mutex, typically a static variable.
+ *
+ * @return xSemaphore Handle to the created mutex semaphore.
+ *
+ * Example usage:
+ <pre>
+ static xStaticSemaphore xMutexBuffer;
+ xSemaphoreHandle xSemaphore;
+
+ void vATask( void * pvParameters )
+ {
+    // Cannot fail, no memory is allocated.
+    xSemaphore = xSemaphoreCreateMutexStatic( &xMutexBuffer );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+
 
 /**
  * semphr. h
@@ -656,6 +691,17 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * The recursive mutex counterpart of xSemaphoreCreateMutexStatic().
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxMutexBuffer ) )
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
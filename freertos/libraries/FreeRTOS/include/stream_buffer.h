@@ -0,0 +1,290 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ * Message buffers use the same type, see message_buffer.h.
+ */
+typedef void * xStreamBufferHandle;
+
+/*
+ * A stream buffer moves a stream of bytes from a single writer, a task or an
+ * interrupt, to a single reader, a task or an interrupt.  Bytes are copied in
+ * and out in bulk rather than one queue item at a time, and a waiting task is
+ * woken with a direct to task notification, so configUSE_TASK_NOTIFICATIONS
+ * must be set to 1 as well as configUSE_STREAM_BUFFERS.
+ *
+ * There is no mutual exclusion between several writers or several readers.
+ * If more than one task writes, or more than one task reads, the calls must
+ * be serialised by the application, for example within a critical section or
+ * with a zero block time while holding a mutex.
+ */
+
+/**
+ * stream_buffer. h
+ * <PRE>xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );</PRE>
+ *
+ * Creates a new stream buffer, with its storage allocated from the FreeRTOS
+ * heap in the same block as its control structure.
+ *
+ * @param xBufferSizeBytes The number of bytes the stream buffer can hold.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the buffer
+ * before a task blocked in xStreamBufferReceive() is woken.  A trigger level
+ * of 1 wakes it for every write, a trigger level of 0 is treated as 1.  The
+ * reader still returns early when its block time expires.
+ *
+ * @return The handle of the new stream buffer, or NULL if there was not
+ * enough heap.
+ *
+ * \page xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );</PRE>
+ *
+ * Copies bytes into a stream buffer.  Must not be called from an interrupt,
+ * see xStreamBufferSendFromISR().
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param pvTxData The bytes to copy into the buffer.
+ *
+ * @param xDataLengthBytes The number of bytes to copy.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for
+ * enough space for all xDataLengthBytes bytes.  When it expires as many bytes
+ * as fit are written.  Setting it to portMAX_DELAY waits indefinitely if
+ * INCLUDE_vTaskSuspend is set to 1.
+ *
+ * @return The number of bytes written, which is less than xDataLengthBytes if
+ * the call timed out.
+ *
+ * \page xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xStreamBufferSend() that can be used from an interrupt service
+ * routine.  It never blocks, it writes as many bytes as there is space for.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the write unblocked a
+ * reader with a priority above that of the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.  May be NULL.
+ *
+ * @return The number of bytes written.
+ *
+ * \page xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );</PRE>
+ *
+ * Copies bytes out of a stream buffer.  Must not be called from an interrupt,
+ * see xStreamBufferReceiveFromISR().
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read from.
+ *
+ * @param pvRxData The buffer the bytes are copied into.
+ *
+ * @param xBufferLengthBytes The most bytes to copy.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for the
+ * buffer to become non-empty.  The task is woken once the trigger level is
+ * reached and returns whatever is available at that point.
+ *
+ * @return The number of bytes read, 0 if the call timed out.
+ *
+ * \page xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xStreamBufferReceive() that can be used from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the read unblocked a
+ * writer with a priority above that of the interrupted task.  May be NULL.
+ *
+ * @return The number of bytes read.
+ *
+ * \page xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );</PRE>
+ *
+ * Frees a stream or message buffer.  No task may be blocked on it.
+ *
+ * \page vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );</PRE>
+ *
+ * Discards the contents of a stream or message buffer.
+ *
+ * @return pdFAIL if a task was blocked on the buffer, in which case it is left
+ * unchanged, otherwise pdPASS.
+ *
+ * \page xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel );</PRE>
+ *
+ * Changes the trigger level given to xStreamBufferCreate().
+ *
+ * @return pdFAIL if xTriggerLevel is larger than the buffer, otherwise
+ * pdPASS.
+ *
+ * \page xStreamBufferSetTriggerLevel xStreamBufferSetTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer );</PRE>
+ *
+ * @return The number of bytes that can be read from the buffer.  For a
+ * message buffer this includes the length stored with each message.
+ *
+ * \page xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <PRE>size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer );</PRE>
+ *
+ * @return The number of bytes that can be written to the buffer.  For a
+ * message buffer this includes the length stored with each message.
+ *
+ * \page xStreamBufferSpacesAvailable xStreamBufferSpacesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#define xStreamBufferIsEmpty( xStreamBuffer ) ( xStreamBufferBytesAvailable( xStreamBuffer ) == ( size_t ) 0 )
+#define xStreamBufferIsFull( xStreamBuffer ) ( xStreamBufferSpacesAvailable( xStreamBuffer ) == ( size_t ) 0 )
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferNextMessageLengthBytes( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STREAM_BUFFER_H */
+
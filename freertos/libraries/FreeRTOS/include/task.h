@@ -131,6 +131,18 @@ typedef struct xTASK_PARAMTERS
 	xMemoryRegion xRegions[ portNUM_CONFIGURABLE_REGIONS ];
 } xTaskParameters;
 
+/*
+ * Actions that can be performed when xTaskNotify() is called.
+ */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
 /*
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -283,6 +295,56 @@ typedef struct xTASK_PARAMTERS
  */
 #define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
 
+/**
+ * task. h
+ *<pre>
+ xTaskHandle xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const signed char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  portSTACK_TYPE * const puxStackBuffer,
+							  xStaticTask * const pxTaskBuffer
+						  );</pre>
+ *
+ * Create a new task without using the FreeRTOS heap.  The parameters are as
+ * for xTaskCreate(), except that the stack and the task control block are
+ * supplied by the application, typically as static variables, so the task
+ * can be created whatever the state of the heap.  The kernel leaves both
+ * alone if the task is deleted.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param puxStackBuffer At least usStackDepth words, used as the stack of the
+ * task.
+ *
+ * @param pxTaskBuffer Holds the task control block.
+ *
+ * @return The handle of the task, or NULL if either buffer is NULL.
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 xHandle = xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE * const puxStackBuffer, xStaticTask * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -554,6 +616,78 @@ void vTaskDelay( portTickType xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskSetPeriodic( xTaskHandle pxTask, portTickType xPeriod, portTickType xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Declare a task periodic.  Its first job is released now, and each call to
+ * vTaskWaitForNextPeriod() completes one job and blocks until the next is
+ * released, xPeriod ticks after the previous one.  Every job is due
+ * xRelativeDeadline ticks after its release; one that completes later is
+ * counted as a deadline miss.
+ *
+ * Periodic tasks at configEDF_PRIORITY form the earliest deadline first
+ * class: among them the ready task with the nearest deadline always runs,
+ * whatever order they became ready in.  That lets a set of periodic tasks use
+ * up to all of the processor time left by the tasks at higher priorities,
+ * where rate monotonic fixed priorities only guarantee about 70%.  Periodic
+ * tasks at other priorities keep their fixed priority and only have their
+ * deadlines tracked.  Calling this again restarts the period and clears the
+ * statistics reported by vTaskListPeriodic().
+ *
+ * The period, deadline and statistics are kept apart from the TCB, allocated
+ * from the heap by the first call for a task and freed when it is deleted.
+ *
+ * @param pxTask The task to declare periodic.  Passing NULL uses the calling
+ * task.
+ *
+ * @param xPeriod The time in ticks between releases.
+ *
+ * @param xRelativeDeadline The time in ticks from a release to the deadline
+ * of its job, at most xPeriod.
+ *
+ * @return pdPASS, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if the state could
+ * not be allocated, the task is then left as it was.
+ *
+ * Example usage:
+   <pre>
+ // Sample every 10 ticks, finishing within 5 ticks of each release.
+ void vSampleTask( void * pvParameters )
+ {
+     xTaskSetPeriodic( NULL, 10, 5 );
+
+     for( ;; )
+     {
+         // Take and process the sample.
+         vTaskWaitForNextPeriod();
+     }
+ }
+   </pre>
+ * \defgroup xTaskSetPeriodic xTaskSetPeriodic
+ * \ingroup TaskCtrl
+ */
+portBASE_TYPE xTaskSetPeriodic( xTaskHandle pxTask, portTickType xPeriod, portTickType xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Complete the current job of the calling periodic task, see
+ * xTaskSetPeriodic(), and block until the next one is released.  A job that
+ * overran into the next period does not block, the next job starts at once
+ * and is likely to miss its deadline too.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle pxTask );</pre>
@@ -1053,6 +1187,28 @@ signed char *pcTaskGetTaskName( xTaskHandle xTaskToQuery );
  */
 void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>void vTaskListPeriodic( char *pcWriteBuffer );</PRE>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.  Like vTaskList() it suspends the scheduler for its duration
+ * and is intended as a debug aid.
+ *
+ * Lists the periodic tasks, one line each with the name, the class ("EDF" at
+ * configEDF_PRIORITY, "FP" otherwise), the period and relative deadline in
+ * ticks, the jobs completed, how many of them missed their deadline, and the
+ * longest response from a release to completion in ticks.
+ *
+ * @param pcWriteBuffer A buffer into which the above mentioned details
+ * will be written, in ascii form.  Approximately 50 bytes per periodic task
+ * should be sufficient.
+ *
+ * \page vTaskListPeriodic vTaskListPeriodic
+ * \ingroup TaskUtils
+ */
+void vTaskListPeriodic( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>void vTaskGetRunTimeStats( char *pcWriteBuffer );</PRE>
@@ -1139,6 +1295,32 @@ unsigned long ulTaskEndTrace( void ) PRIVILEGED_FUNCTION;
  */
 unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <PRE>void vTaskWalkStacks( tskSTACK_CALLBACK pxCallback, void *pvParameter );</PRE>
+ *
+ * INCLUDE_vTaskWalkStacks must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Calls pxCallback once for every task the scheduler knows of, including
+ * tasks waiting to be cleaned up by the idle task, with the depth the task
+ * stack was created with and its high water mark, both in words.  The depth
+ * less the high water mark is the most stack the task has used so far.
+ *
+ * The scheduler is suspended for the whole walk, so the callback must not
+ * block.  Like vTaskList() this is intended for debugging only.
+ *
+ * @param pxCallback Called as pxCallback( xTask, pcTaskName, usStackDepth,
+ * usMinimumFree, pvParameter ) for each task.
+ *
+ * @param pvParameter Passed through to pxCallback.
+ *
+ * \page vTaskWalkStacks vTaskWalkStacks
+ * \ingroup TaskUtils
+ */
+typedef void ( *tskSTACK_CALLBACK )( xTaskHandle xTask, const signed char *pcTaskName, unsigned short usStackDepth, unsigned short usMinimumFree, void *pvParameter );
+void vTaskWalkStacks( tskSTACK_CALLBACK pxCallback, void *pvParameter ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include tasks.h before
 FreeRTOS.h.  When this is done pdTASK_HOOK_CODE will not yet have been defined,
 so the following two prototypes will cause a compilation error.  This can be
@@ -1188,6 +1370,136 @@ portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter
  */
 xTaskHandle xTaskGetIdleTaskHandle( void );
 
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * Each task has a 32-bit notification value and a pending state, both held in
+ * its TCB.  Notifying a task sends it an event directly, without a queue,
+ * semaphore or event group in between, and unblocks it if it is waiting in
+ * xTaskNotifyWait() or ulTaskNotifyTake().  Only one task can be the
+ * receiver, so a notification replaces a binary or counting semaphore, or a
+ * one item queue, where a single known task waits on it.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data sent with the notification, used as eAction says.
+ *
+ * @param eAction One of:
+ *
+ *	eSetBits - the notification value is bitwise ORed with ulValue, which
+ *	gives a light weight event group.
+ *
+ *	eIncrement - the notification value is incremented and ulValue unused,
+ *	which gives a light weight counting semaphore, see xTaskNotifyGive().
+ *
+ *	eSetValueWithOverwrite - the notification value is set to ulValue even if
+ *	the task has not consumed the previous notification yet.
+ *
+ *	eSetValueWithoutOverwrite - the notification value is set to ulValue
+ *	unless a notification is already pending, in which case nothing changes
+ *	and pdFAIL is returned.
+ *
+ *	eNoAction - the task is notified without its value being changed.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the value could
+ * not be set, otherwise pdPASS.
+ *
+ * \page xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotify() that can be used from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the notification unblocked
+ * a task with a priority above that of the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.  May be NULL.
+ *
+ * \page xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</PRE>
+ *
+ * Waits, optionally in the Blocked state, for the calling task to be
+ * notified.
+ *
+ * @param ulBitsToClearOnEntry Bits cleared in the notification value on
+ * entry, if no notification is already pending.  ULONG_MAX clears it all.
+ *
+ * @param ulBitsToClearOnExit Bits cleared in the notification value before
+ * returning, if a notification was received.
+ *
+ * @param pulNotificationValue Receives the notification value before the
+ * ulBitsToClearOnExit bits are cleared.  May be NULL.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdTRUE if a notification was received, or was already pending,
+ * pdFALSE if the call timed out.
+ *
+ * \page xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</PRE>
+ *
+ * Increments the notification value of xTaskToNotify, the equivalent of
+ * giving a semaphore the task takes with ulTaskNotifyTake().
+ *
+ * \page xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskNotify( ( xTaskToNotify ), 0UL, eIncrement )
+
+/**
+ * task. h
+ * <PRE>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotifyGive() that can be used from an interrupt service
+ * routine, see xTaskNotifyFromISR() for pxHigherPriorityTaskWoken.
+ *
+ * \page vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</PRE>
+ *
+ * Waits for the notification value of the calling task to become non-zero,
+ * the equivalent of taking a semaphore given with xTaskNotifyGive().
+ *
+ * @param xClearCountOnExit pdTRUE clears the value to zero on exit, so it
+ * acts as a binary semaphore; pdFALSE decrements it, as a counting
+ * semaphore.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return The notification value before it was cleared or decremented, 0 if
+ * the call timed out.
+ *
+ * \page ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
  *----------------------------------------------------------*/
@@ -1204,6 +1516,31 @@ xTaskHandle xTaskGetIdleTaskHandle( void );
  */
 void vTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Only available when configUSE_TICKLESS_IDLE is 1.  Called from
+ * portSUPPRESS_TICKS_AND_SLEEP() on wake up, with the scheduler suspended, to
+ * add the tick periods that passed without a tick interrupt to the tick count.
+ */
+void vTaskStepTick( portTickType xTicksToJump ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * Only available when configUSE_TICKLESS_IDLE is 1.  Called from
+ * portSUPPRESS_TICKS_AND_SLEEP() just before the processor sleeps.  Returns
+ * pdFALSE if a task was readied or a context switch was requested since the
+ * idle task decided to sleep, in which case the sleep must be abandoned.
+ */
+portBASE_TYPE xTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -1259,6 +1596,31 @@ void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickT
  */
 signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT GROUPS.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * vTaskPlaceOnUnorderedEventList() appends the calling task to an event list
+ * without sorting it, storing xItemValue (the bits waited for and the wait
+ * options) in its event list item.  xTaskRemoveFromUnorderedEventList()
+ * removes the task owning pxEventListItem, leaving xItemValue (the event bits
+ * that unblocked it) for the task to collect with uxTaskResetEventItemValue().
+ *
+ * @return xTaskRemoveFromUnorderedEventList() returns pdTRUE if the task being
+ * removed has a higher priority than the task making the call, otherwise
+ * pdFALSE.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the calling task's event list item value and restores it to the
+ * priority ordered value used by queues and semaphores.
+ */
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
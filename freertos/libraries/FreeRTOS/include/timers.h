@@ -83,6 +83,8 @@ extern "C" {
 /* IDs for commands that can be sent/received on the timer queue.  These are to
 be used solely through the macros that make up the public software timer API,
 as defined below. */
+#define tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR	( -2 )
+#define tmrCOMMAND_EXECUTE_CALLBACK			( -1 )
 #define tmrCOMMAND_START					0
 #define tmrCOMMAND_STOP						1
 #define tmrCOMMAND_CHANGE_PERIOD			2
@@ -103,6 +105,10 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/* Define the prototype of functions pended with xTimerPendFunctionCall() and
+xTimerPendFunctionCallFromISR(). */
+typedef void (*tmrPENDED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriodInTicks,
@@ -936,6 +942,54 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                              void *pvParameter1,
+ *                                              unsigned long ulParameter2,
+ *                                              signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ *
+ * Defers the execution of a function to the timer service task (daemon).
+ * INCLUDE_xTimerPendFunctionCall must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * An interrupt service routine can use this to hand work that takes an
+ * unbounded or long time, or that calls API functions interrupts cannot
+ * call, to a task.  The function is called, with the two parameters given
+ * here, once the timer service task has processed all the commands queued
+ * before it.  Its priority is configTIMER_TASK_PRIORITY.
+ *
+ * @param xFunctionToPend The function to execute from the timer service task.
+ *
+ * @param pvParameter1 The value passed as the function's first parameter.
+ *
+ * @param ulParameter2 The value passed as the function's second parameter.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the call
+ * unblocked the timer service task and that task has a priority above the
+ * interrupted task, in which case a context switch should be requested
+ * before the interrupt exits.
+ *
+ * @return pdPASS if the call was posted to the timer command queue.  pdFAIL
+ * if the queue was full, or does not exist yet because the scheduler has not
+ * been started and no timer has been created.
+ */
+portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                       void *pvParameter1,
+ *                                       unsigned long ulParameter2,
+ *                                       portTickType xTicksToWait );
+ *
+ * The same as xTimerPendFunctionCallFromISR(), for use from a task.
+ *
+ * @param xTicksToWait The time to wait in the Blocked state for space on the
+ * timer command queue if it is full.
+ *
+ * @return pdPASS if the call was posted to the timer command queue.
+ */
+portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait );
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -0,0 +1,354 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "mailbox.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include mailbox functionality.  This #if is closed at the very bottom of
+this file.  If you want to include mailboxes then ensure configUSE_MAILBOXES is
+set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_MAILBOXES == 1 )
+
+/* Values of uxState in the header of a buffer. */
+#define mbBUFFER_FREE			( ( unsigned portBASE_TYPE ) 0U )
+#define mbBUFFER_HELD			( ( unsigned portBASE_TYPE ) 1U )
+#define mbBUFFER_IN_MAILBOX		( ( unsigned portBASE_TYPE ) 2U )
+
+/* The definition of a pool.  The free buffers are kept in a queue of
+pointers, so a task borrowing from an empty pool blocks exactly as it would
+on any other queue.  The pool structure and all its buffers are allocated in
+one block, the queue in another. */
+typedef struct xMAILBOX_POOL
+{
+	xQueueHandle xFreeBuffers;				/*<< Pointers to the buffers nobody holds. */
+	unsigned portBASE_TYPE uxBufferCount;
+	size_t xBufferSize;						/*<< The usable size of each buffer. */
+	mbRELEASE_CALLBACK pxReleaseCallback;	/*<< Called as a buffer is returned, may be NULL. */
+} xMAILBOX_POOL;
+
+/* Stored immediately in front of each buffer. */
+typedef struct xMAILBOX_BUFFER_HEADER
+{
+	xMAILBOX_POOL *pxPool;					/*<< The pool the buffer belongs to. */
+	volatile unsigned portBASE_TYPE uxState;	/*<< One of the mbBUFFER_ values. */
+} xMAILBOX_BUFFER_HEADER;
+
+/* Sizes rounded up so that every buffer keeps the alignment pvPortMalloc()
+gives the block. */
+#define mbALIGN( xSize )	( ( ( xSize ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define mbPOOL_SIZE			mbALIGN( sizeof( xMAILBOX_POOL ) )
+#define mbHEADER_SIZE		mbALIGN( sizeof( xMAILBOX_BUFFER_HEADER ) )
+
+#define mbHEADER( pvBuffer )	( ( xMAILBOX_BUFFER_HEADER * ) ( ( ( unsigned char * ) ( pvBuffer ) ) - mbHEADER_SIZE ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Mark a buffer held by the caller as free, call the release callback of its
+ * pool and return the header of the buffer.
+ */
+static xMAILBOX_BUFFER_HEADER *prvReleaseBuffer( void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xMailboxPoolHandle xMailboxPoolCreate( unsigned portBASE_TYPE uxBufferCount, size_t xBufferSize, mbRELEASE_CALLBACK pxReleaseCallback )
+{
+xMAILBOX_POOL *pxPool;
+xMAILBOX_BUFFER_HEADER *pxHeader;
+unsigned char *pucBuffer;
+void *pvBuffer;
+size_t xStride;
+unsigned portBASE_TYPE ux;
+
+	configASSERT( uxBufferCount > ( unsigned portBASE_TYPE ) 0 );
+	configASSERT( xBufferSize > ( size_t ) 0 );
+
+	xStride = mbHEADER_SIZE + mbALIGN( xBufferSize );
+	pxPool = ( xMAILBOX_POOL * ) pvPortMalloc( mbPOOL_SIZE + ( xStride * ( size_t ) uxBufferCount ) );
+
+	if( pxPool != NULL )
+	{
+		pxPool->xFreeBuffers = xQueueCreate( uxBufferCount, sizeof( void * ) );
+
+		if( pxPool->xFreeBuffers != NULL )
+		{
+			pxPool->uxBufferCount = uxBufferCount;
+			pxPool->xBufferSize = xBufferSize;
+			pxPool->pxReleaseCallback = pxReleaseCallback;
+
+			pucBuffer = ( ( unsigned char * ) pxPool ) + mbPOOL_SIZE;
+			for( ux = 0; ux < uxBufferCount; ux++ )
+			{
+				pxHeader = ( xMAILBOX_BUFFER_HEADER * ) pucBuffer;
+				pxHeader->pxPool = pxPool;
+				pxHeader->uxState = mbBUFFER_FREE;
+
+				/* The queue has room for every buffer so this cannot fail. */
+				pvBuffer = pucBuffer + mbHEADER_SIZE;
+				( void ) xQueueSend( pxPool->xFreeBuffers, &pvBuffer, ( portTickType ) 0 );
+				pucBuffer += xStride;
+			}
+		}
+		else
+		{
+			vPortFree( pxPool );
+			pxPool = NULL;
+		}
+	}
+
+	return ( xMailboxPoolHandle ) pxPool;
+}
+/*-----------------------------------------------------------*/
+
+void vMailboxPoolDelete( xMailboxPoolHandle xPool )
+{
+xMAILBOX_POOL *pxPool = ( xMAILBOX_POOL * ) xPool;
+
+	configASSERT( pxPool );
+
+	/* Every buffer must have been returned. */
+	configASSERT( uxQueueMessagesWaiting( pxPool->xFreeBuffers ) == pxPool->uxBufferCount );
+
+	vQueueDelete( pxPool->xFreeBuffers );
+	vPortFree( pxPool );
+}
+/*-----------------------------------------------------------*/
+
+void *pvMailboxBorrow( xMailboxPoolHandle xPool, portTickType xTicksToWait )
+{
+xMAILBOX_POOL *pxPool = ( xMAILBOX_POOL * ) xPool;
+void *pvBuffer;
+
+	configASSERT( pxPool );
+
+	if( xQueueReceive( pxPool->xFreeBuffers, &pvBuffer, xTicksToWait ) != pdPASS )
+	{
+		return NULL;
+	}
+
+	configASSERT( mbHEADER( pvBuffer )->uxState == mbBUFFER_FREE );
+	mbHEADER( pvBuffer )->uxState = mbBUFFER_HELD;
+
+	return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMailboxBorrowFromISR( xMailboxPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xMAILBOX_POOL *pxPool = ( xMAILBOX_POOL * ) xPool;
+void *pvBuffer;
+
+	configASSERT( pxPool );
+
+	if( xQueueReceiveFromISR( pxPool->xFreeBuffers, &pvBuffer, pxHigherPriorityTaskWoken ) != pdPASS )
+	{
+		return NULL;
+	}
+
+	configASSERT( mbHEADER( pvBuffer )->uxState == mbBUFFER_FREE );
+	mbHEADER( pvBuffer )->uxState = mbBUFFER_HELD;
+
+	return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static xMAILBOX_BUFFER_HEADER *prvReleaseBuffer( void *pvBuffer )
+{
+xMAILBOX_BUFFER_HEADER *pxHeader;
+
+	configASSERT( pvBuffer );
+
+	pxHeader = mbHEADER( pvBuffer );
+	configASSERT( pxHeader->uxState == mbBUFFER_HELD );
+
+	/* The caller still owns the buffer while the callback runs, nobody else
+	can borrow it until it is back in the free queue. */
+	if( pxHeader->pxPool->pxReleaseCallback != NULL )
+	{
+		pxHeader->pxPool->pxReleaseCallback( pvBuffer );
+	}
+	pxHeader->uxState = mbBUFFER_FREE;
+
+	return pxHeader;
+}
+/*-----------------------------------------------------------*/
+
+void vMailboxReturn( void *pvBuffer )
+{
+xMAILBOX_BUFFER_HEADER *pxHeader = prvReleaseBuffer( pvBuffer );
+
+	/* There is always room in the free queue for a buffer of the pool. */
+	( void ) xQueueSend( pxHeader->pxPool->xFreeBuffers, &pvBuffer, ( portTickType ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vMailboxReturnFromISR( void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xMAILBOX_BUFFER_HEADER *pxHeader = prvReleaseBuffer( pvBuffer );
+
+	( void ) xQueueSendFromISR( pxHeader->pxPool->xFreeBuffers, &pvBuffer, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+size_t xMailboxBufferSize( void *pvBuffer )
+{
+	configASSERT( pvBuffer );
+
+	return mbHEADER( pvBuffer )->pxPool->xBufferSize;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xMailboxPost( xMailboxHandle xMailbox, void *pvBuffer, portTickType xTicksToWait )
+{
+xMAILBOX_BUFFER_HEADER *pxHeader;
+portBASE_TYPE xReturn;
+
+	configASSERT( pvBuffer );
+
+	pxHeader = mbHEADER( pvBuffer );
+	configASSERT( pxHeader->uxState == mbBUFFER_HELD );
+
+	/* The state must change before the pointer is sent, the task fetching it
+	may run before xQueueSend() returns. */
+	pxHeader->uxState = mbBUFFER_IN_MAILBOX;
+	xReturn = xQueueSend( xMailbox, &pvBuffer, xTicksToWait );
+	if( xReturn != pdPASS )
+	{
+		pxHeader->uxState = mbBUFFER_HELD;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xMailboxPostFromISR( xMailboxHandle xMailbox, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xMAILBOX_BUFFER_HEADER *pxHeader;
+portBASE_TYPE xReturn;
+
+	configASSERT( pvBuffer );
+
+	pxHeader = mbHEADER( pvBuffer );
+	configASSERT( pxHeader->uxState == mbBUFFER_HELD );
+
+	pxHeader->uxState = mbBUFFER_IN_MAILBOX;
+	xReturn = xQueueSendFromISR( xMailbox, &pvBuffer, pxHigherPriorityTaskWoken );
+	if( xReturn != pdPASS )
+	{
+		pxHeader->uxState = mbBUFFER_HELD;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMailboxFetch( xMailboxHandle xMailbox, portTickType xTicksToWait )
+{
+void *pvBuffer;
+
+	if( xQueueReceive( xMailbox, &pvBuffer, xTicksToWait ) != pdPASS )
+	{
+		return NULL;
+	}
+
+	configASSERT( mbHEADER( pvBuffer )->uxState == mbBUFFER_IN_MAILBOX );
+	mbHEADER( pvBuffer )->uxState = mbBUFFER_HELD;
+
+	return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMailboxFetchFromISR( xMailboxHandle xMailbox, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+void *pvBuffer;
+
+	if( xQueueReceiveFromISR( xMailbox, &pvBuffer, pxHigherPriorityTaskWoken ) != pdPASS )
+	{
+		return NULL;
+	}
+
+	configASSERT( mbHEADER( pvBuffer )->uxState == mbBUFFER_IN_MAILBOX );
+	mbHEADER( pvBuffer )->uxState = mbBUFFER_HELD;
+
+	return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include mailbox functionality.  If you want to include mailboxes then
+ensure configUSE_MAILBOXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MAILBOXES == 1 */
+
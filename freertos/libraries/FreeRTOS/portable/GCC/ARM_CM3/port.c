@@ -82,11 +82,13 @@ FreeRTOS.org versions prior to V4.4.0 did not include this definition. */
 /* Constants required to manipulate the NVIC. */
 #define portNVIC_SYSTICK_CTRL		( ( volatile unsigned long *) 0xe000e010 )
 #define portNVIC_SYSTICK_LOAD		( ( volatile unsigned long *) 0xe000e014 )
+#define portNVIC_SYSTICK_CURRENT_VALUE	( ( volatile unsigned long *) 0xe000e018 )
 #define portNVIC_INT_CTRL			( ( volatile unsigned long *) 0xe000ed04 )
 #define portNVIC_SYSPRI2			( ( volatile unsigned long *) 0xe000ed20 )
 #define portNVIC_SYSTICK_CLK		0x00000004
 #define portNVIC_SYSTICK_INT		0x00000002
 #define portNVIC_SYSTICK_ENABLE		0x00000001
+#define portNVIC_SYSTICK_COUNT_FLAG	0x00010000
 #define portNVIC_PENDSVSET			0x10000000
 #define portNVIC_PENDSV_PRI			( ( ( unsigned long ) configKERNEL_INTERRUPT_PRIORITY ) << 16 )
 #define portNVIC_SYSTICK_PRI		( ( ( unsigned long ) configKERNEL_INTERRUPT_PRIORITY ) << 24 )
@@ -94,6 +96,13 @@ FreeRTOS.org versions prior to V4.4.0 did not include this definition. */
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR			( 0x01000000 )
 
+/* The SysTick is a 24-bit counter. */
+#define portMAX_24_BIT_NUMBER		( 0xffffffUL )
+
+/* Approximate number of SysTick counts lost while the timer is stopped to be
+reprogrammed in vPortSuppressTicksAndSleep(). */
+#define portMISSED_COUNTS_FACTOR	( 45UL )
+
 /* The priority used by the kernel is assigned to a variable to make access
 from inline assembler easier. */
 const unsigned long ulKernelPriority = configKERNEL_INTERRUPT_PRIORITY;
@@ -102,6 +111,20 @@ const unsigned long ulKernelPriority = configKERNEL_INTERRUPT_PRIORITY;
 variable. */
 static unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	/* SysTick counts in one tick period, the most tick periods one SysTick
+	reload can cover, and the counts lost while the timer is stopped. */
+	static unsigned long ulTimerCountsForOneTick = 0;
+	static unsigned long xMaximumPossibleSuppressedTicks = 0;
+	static unsigned long ulStoppedTimerCompensation = 0;
+
+	/* Tick interrupts avoided by sleeping, and the sleeps that did so. */
+	static unsigned long ulSuppressedTicks = 0;
+	static unsigned long ulTicklessSleeps = 0;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -217,12 +240,14 @@ void vPortEnterCritical( void )
 {
 	portDISABLE_INTERRUPTS();
 	uxCriticalNesting++;
+	traceCRITICAL_ENTER( uxCriticalNesting );
 }
 /*-----------------------------------------------------------*/
 
 void vPortExitCritical( void )
 {
 	uxCriticalNesting--;
+	traceCRITICAL_EXIT( uxCriticalNesting );
 	if( uxCriticalNesting == 0 )
 	{
 		portENABLE_INTERRUPTS();
@@ -269,6 +294,9 @@ void xPortSysTickHandler( void )
 {
 unsigned long ulDummy;
 
+	traceTICK_ENTER();
+	traceISR_ENTER();
+
 	/* If using preemption, also force a context switch. */
 	#if configUSE_PREEMPTION == 1
 		*(portNVIC_INT_CTRL) = portNVIC_PENDSVSET;
@@ -279,6 +307,8 @@ unsigned long ulDummy;
 		vTaskIncrementTick();
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( ulDummy );
+
+	traceISR_EXIT();
 }
 /*-----------------------------------------------------------*/
 
@@ -288,9 +318,141 @@ unsigned long ulDummy;
  */
 void prvSetupTimerInterrupt( void )
 {
+	/* Calculate the constants required to configure the tick interrupt. */
+	#if configUSE_TICKLESS_IDLE == 1
+	{
+		ulTimerCountsForOneTick = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ );
+		xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+		ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR;
+	}
+	#endif
+
 	/* Configure SysTick to interrupt at the requested rate. */
 	*(portNVIC_SYSTICK_LOAD) = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
 	*(portNVIC_SYSTICK_CTRL) = portNVIC_SYSTICK_CLK | portNVIC_SYSTICK_INT | portNVIC_SYSTICK_ENABLE;
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	__attribute__(( weak )) void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+	{
+	unsigned long ulReloadValue, ulCompleteTickPeriods, ulCompletedSysTickDecrements;
+	unsigned long ulSysTickCTRL;
+
+		/* Called by the idle task with the scheduler suspended.  The SysTick
+		is reprogrammed to fire when the first blocked task is due, which a
+		24-bit counter limits to xMaximumPossibleSuppressedTicks periods. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
+
+		/* Stop the SysTick momentarily.  The time it is stopped for is
+		accounted for as best it can be, but using the tickless mode will
+		inevitably result in some tiny drift of the time maintained by the
+		kernel with respect to calendar time. */
+		*(portNVIC_SYSTICK_CTRL) &= ~portNVIC_SYSTICK_ENABLE;
+
+		/* The current tick period is partly gone, the rest of it plus whole
+		periods for the remaining ticks make up the new reload value. */
+		ulReloadValue = *(portNVIC_SYSTICK_CURRENT_VALUE) + ( ulTimerCountsForOneTick * ( xExpectedIdleTime - 1UL ) );
+		if( ulReloadValue > ulStoppedTimerCompensation )
+		{
+			ulReloadValue -= ulStoppedTimerCompensation;
+		}
+
+		/* Mask every interrupt, not just the kernel ones, so none can run
+		between the check below and the wfi.  A pending interrupt still ends
+		the wfi, it is taken once interrupts are enabled again. */
+		__asm volatile( "cpsid i" );
+
+		if( xTaskConfirmSleepModeStatus() == pdFALSE )
+		{
+			/* A task became ready or a context switch was requested since
+			the idle task decided to sleep.  Restart the SysTick from its
+			current count and go back to the scheduler. */
+			*(portNVIC_SYSTICK_LOAD) = *(portNVIC_SYSTICK_CURRENT_VALUE);
+			*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+			*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+			*(portNVIC_SYSTICK_LOAD) = ulTimerCountsForOneTick - 1UL;
+
+			__asm volatile( "cpsie i" );
+			return;
+		}
+
+		/* Restart the SysTick with the long period.  Writing the current
+		value register reloads the counter and clears the count flag. */
+		*(portNVIC_SYSTICK_LOAD) = ulReloadValue;
+		*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+		*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+
+		configPRE_SLEEP_PROCESSING( xExpectedIdleTime );
+		if( xExpectedIdleTime > 0 )
+		{
+			__asm volatile( "dsb" );
+			__asm volatile( "wfi" );
+			__asm volatile( "isb" );
+		}
+		configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+		/* Stop the SysTick.  Reading the control register clears the count
+		flag so keep the value read. */
+		ulSysTickCTRL = *(portNVIC_SYSTICK_CTRL);
+		*(portNVIC_SYSTICK_CTRL) = ( ulSysTickCTRL & ~portNVIC_SYSTICK_ENABLE );
+
+		if( ( ulSysTickCTRL & portNVIC_SYSTICK_COUNT_FLAG ) != 0 )
+		{
+		unsigned long ulCalculatedLoadValue;
+
+			/* The SysTick reached zero, so the tick interrupt is pending and
+			will account for the last period once interrupts are enabled.
+			Reload for whatever is left of the period it is already in. */
+			ulCalculatedLoadValue = ( ulTimerCountsForOneTick - 1UL ) - ( ulReloadValue - *(portNVIC_SYSTICK_CURRENT_VALUE) );
+
+			/* Don't allow a tiny value, or values that have somehow
+			underflowed because the post sleep hook did something that took
+			too long. */
+			if( ( ulCalculatedLoadValue < ulStoppedTimerCompensation ) || ( ulCalculatedLoadValue > ulTimerCountsForOneTick ) )
+			{
+				ulCalculatedLoadValue = ( ulTimerCountsForOneTick - 1UL );
+			}
+
+			*(portNVIC_SYSTICK_LOAD) = ulCalculatedLoadValue;
+			ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+		}
+		else
+		{
+			/* Something other than the tick interrupt ended the sleep.  Work
+			out how many whole tick periods passed, and reload for the rest
+			of the one in progress. */
+			ulCompletedSysTickDecrements = ( xExpectedIdleTime * ulTimerCountsForOneTick ) - *(portNVIC_SYSTICK_CURRENT_VALUE);
+			ulCompleteTickPeriods = ulCompletedSysTickDecrements / ulTimerCountsForOneTick;
+			*(portNVIC_SYSTICK_LOAD) = ( ( ulCompleteTickPeriods + 1UL ) * ulTimerCountsForOneTick ) - ulCompletedSysTickDecrements;
+		}
+
+		/* Restart the SysTick for the partial period, then put back the
+		normal reload value, which only takes effect when it next reloads. */
+		*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+		*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+		vTaskStepTick( ulCompleteTickPeriods );
+		*(portNVIC_SYSTICK_LOAD) = ulTimerCountsForOneTick - 1UL;
+
+		ulSuppressedTicks += ulCompleteTickPeriods;
+		ulTicklessSleeps++;
+
+		__asm volatile( "cpsie i" );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetTicklessStats( unsigned long *pulSleeps, unsigned long *pulSuppressedTicks )
+	{
+		portENTER_CRITICAL();
+		{
+			*pulSleeps = ulTicklessSleeps;
+			*pulSuppressedTicks = ulSuppressedTicks;
+		}
+		portEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
@@ -155,6 +155,56 @@ extern void vPortExitCritical( void );
 #define portEXIT_CRITICAL()			vPortExitCritical()
 /*-----------------------------------------------------------*/
 
+/* Ready priority bitmap used by configUSE_PORT_OPTIMISED_TASK_SELECTION.  The
+highest set bit is found with a single CLZ instruction. */
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )	uxTopPriority = ( 31 - __builtin_clz( ( uxReadyPriorities ) ) )
+
+#endif
+/*-----------------------------------------------------------*/
+
+/* Compare-and-swap for the fast mutexes, see fast_mutex.h.  Every exception
+entry and return clears the exclusive monitor, so a STREX interrupted by a
+context switch fails and the LDREX is tried again.  The core is single, the
+memory clobbers keep the compiler from moving accesses across it and no DMB is
+needed. */
+static inline portBASE_TYPE xPortCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExpected, unsigned long ulNew )
+{
+unsigned long ulValue, ulFailed;
+
+	do
+	{
+		__asm volatile ( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulDestination ) : "memory" );
+		if( ulValue != ulExpected )
+		{
+			__asm volatile ( "clrex" ::: "memory" );
+			return pdFALSE;
+		}
+		__asm volatile ( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulDestination ), "r" ( ulNew ) : "memory" );
+	} while( ulFailed != 0 );
+
+	return pdTRUE;
+}
+
+#define portCOMPARE_AND_SWAP( pulDestination, ulExpected, ulNew )	xPortCompareAndSwap( ( pulDestination ), ( ulExpected ), ( ulNew ) )
+/*-----------------------------------------------------------*/
+
+/* Tickless idle, the SysTick is stopped while the idle task sleeps through
+the ticks in which no task needs to run. */
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+	/* Sleeps taken so far and the tick interrupts they avoided. */
+	extern void vPortGetTicklessStats( unsigned long *pulSleeps, unsigned long *pulSuppressedTicks );
+
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
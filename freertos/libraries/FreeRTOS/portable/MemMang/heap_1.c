@@ -73,12 +73,16 @@
  * management pages of http://www.FreeRTOS.org for more information.
  */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -125,6 +129,8 @@ void *pvReturn = NULL;
 		}	
 	}
 	xTaskResumeAll();
+
+	traceMALLOC( pvReturn, xWantedSize );
 	
 	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
 	{
@@ -149,6 +155,30 @@ void vPortFree( void *pv )
 }
 /*-----------------------------------------------------------*/
 
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+size_t xCopySize;
+void *pvReturn;
+
+	/* Memory is never freed, so a block can only be moved into a new one.
+	Blocks carry no size either, everything from pv to the end of the
+	allocated space is the most that can belong to it. */
+	vTaskSuspendAll();
+	{
+		xCopySize = ( pv == NULL ) ? 0 : ( size_t ) ( &( xHeap.ucHeap[ xNextFreeByte ] ) - ( unsigned char * ) pv );
+	}
+	xTaskResumeAll();
+
+	pvReturn = pvPortMalloc( xWantedSize );
+	if( ( pvReturn != NULL ) && ( xCopySize > 0 ) )
+	{
+		memcpy( pvReturn, pv, ( xCopySize < xWantedSize ) ? xCopySize : xWantedSize );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* Only required when static memory is not cleared. */
@@ -160,6 +190,27 @@ size_t xPortGetFreeHeapSize( void )
 {
 	return ( configTOTAL_HEAP_SIZE - xNextFreeByte );
 }
+/*-----------------------------------------------------------*/
+
+size_t xPortGetTotalHeapSize( void )
+{
+	return configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+	{
+		/* Everything past xNextFreeByte is one free block. */
+		vTaskSuspendAll();
+		{
+			pxCallback( &( xHeap.ucHeap[ xNextFreeByte ] ), configTOTAL_HEAP_SIZE - xNextFreeByte, pvParameter );
+		}
+		xTaskResumeAll();
+	}
+
+#endif
 
 
 
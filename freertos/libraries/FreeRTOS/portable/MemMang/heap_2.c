@@ -73,12 +73,16 @@
  * management pages of http://www.FreeRTOS.org for more information.
  */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -240,6 +244,8 @@ void *pvReturn = NULL;
 	}
 	xTaskResumeAll();
 
+	traceMALLOC( pvReturn, xWantedSize );
+
 	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
 	{
 		if( pvReturn == NULL )
@@ -267,6 +273,7 @@ xBlockLink *pxLink;
 
 		/* This casting is to keep the compiler from issuing warnings. */
 		pxLink = ( void * ) puc;
+		traceFREE( pv, pxLink->xBlockSize );
 
 		vTaskSuspendAll();
 		{
@@ -279,12 +286,76 @@ xBlockLink *pxLink;
 }
 /*-----------------------------------------------------------*/
 
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink;
+void *pvReturn;
+
+	if( pv == NULL )
+	{
+		return pvPortMalloc( xWantedSize );
+	}
+
+	if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+		return NULL;
+	}
+
+	/* Free blocks are not kept in address order, so the block cannot grow
+	into its neighbour.  It stays put if it is already big enough. */
+	puc -= heapSTRUCT_SIZE;
+	pxLink = ( void * ) puc;
+	if( ( xWantedSize + heapSTRUCT_SIZE ) <= pxLink->xBlockSize )
+	{
+		return pv;
+	}
+
+	pvReturn = pvPortMalloc( xWantedSize );
+	if( pvReturn != NULL )
+	{
+		memcpy( pvReturn, pv, pxLink->xBlockSize - heapSTRUCT_SIZE );
+		vPortFree( pv );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 size_t xPortGetFreeHeapSize( void )
 {
 	return xFreeBytesRemaining;
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetTotalHeapSize( void )
+{
+	return configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+	{
+	xBlockLink *pxBlock;
+
+		/* The free list is in size order, xStart is not linked until the
+		first allocation. */
+		vTaskSuspendAll();
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != &xEnd ); pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				pxCallback( pxBlock, pxBlock->xBlockSize, pvParameter );
+			}
+		}
+		xTaskResumeAll();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -83,6 +83,9 @@ all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -100,6 +103,8 @@ void *pvReturn;
 	}
 	xTaskResumeAll();
 
+	traceMALLOC( pvReturn, xWantedSize );
+
 	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
 	{
 		if( pvReturn == NULL )
@@ -118,6 +123,8 @@ void vPortFree( void *pv )
 {
 	if( pv )
 	{
+		traceFREE( pv, 0 );
+
 		vTaskSuspendAll();
 		{
 			free( pv );
@@ -125,6 +132,42 @@ void vPortFree( void *pv )
 		xTaskResumeAll();
 	}
 }
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+void *pvReturn;
+
+	vTaskSuspendAll();
+	{
+		pvReturn = realloc( pv, xWantedSize );
+	}
+	xTaskResumeAll();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
 
+size_t xPortGetFreeHeapSize( void )
+{
+	/* The C library owns the memory, its free space is not known here. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
 
+size_t xPortGetTotalHeapSize( void )
+{
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+	{
+		/* Nothing to report for the same reason. */
+		( void ) pxCallback;
+		( void ) pvParameter;
+	}
 
+#endif
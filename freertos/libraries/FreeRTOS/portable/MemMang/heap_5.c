@@ -0,0 +1,470 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A heap spread over one or more regions of RAM, in the style of heap_5.
+ *
+ * Instead of a fixed configTOTAL_HEAP_SIZE array in .bss, the heap is built
+ * from whatever memory the image leaves unused.  By default that is the single
+ * region main.ld places between the end of .bss (_sheap) and the main stack
+ * reserved at the top of RAM (_eheap), so the heap grows automatically as
+ * static data shrinks.  An application with more free memory (external SRAM,
+ * a gap left by the linker) describes all of it with vPortDefineHeapRegions()
+ * before the first allocation.
+ *
+ * Free blocks are kept in address order and merged with both neighbours when
+ * freed.  Every region ends with a zero sized marker so blocks are never
+ * merged across regions.
+ *
+ * Select it with HEAP_IMPL = heap_5 in the Makefile.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} xBlockLink;
+
+#define heapSTRUCT_SIZE			( ( size_t ) ( ( sizeof( xBlockLink ) + portBYTE_ALIGNMENT_MASK ) & ~portBYTE_ALIGNMENT_MASK ) )
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( heapSTRUCT_SIZE * 2 ) )
+
+/* Provided by main.ld: the free RAM between .bss and the main stack. */
+extern unsigned char _sheap[];
+extern unsigned char _eheap[];
+
+/* xStart heads the free list, pxEnd is the marker at the end of the last
+region.  pxEnd stays NULL until the regions have been defined. */
+static xBlockLink xStart, *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = ( size_t ) 0;
+static size_t xTotalHeapSize = ( size_t ) 0;
+
+/*
+ * Insert a block into the list of free blocks, which is ordered by address,
+ * merging it with the blocks on either side when they are adjacent.
+ */
+static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert );
+
+/*
+ * Define the default region from the linker symbols, used when the
+ * application did not call vPortDefineHeapRegions().
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert )
+{
+xBlockLink *pxIterator;
+unsigned char *puc;
+
+	/* Iterate through the list until a block is found that has a higher
+	address than the block being inserted. */
+	for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* There is nothing to do here, just iterate to the right position. */
+	}
+
+	/* Does the block being inserted follow the block before it? */
+	puc = ( unsigned char * ) pxIterator;
+	if( ( pxIterator != &xStart ) && ( ( puc + pxIterator->xBlockSize ) == ( unsigned char * ) pxBlockToInsert ) )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+
+	/* Does the block after it follow the block being inserted?  Region
+	markers are never merged, their size of zero would end the region. */
+	puc = ( unsigned char * ) pxBlockToInsert;
+	if( ( ( puc + pxBlockToInsert->xBlockSize ) == ( unsigned char * ) pxIterator->pxNextFreeBlock ) &&
+		( pxIterator->pxNextFreeBlock->xBlockSize != 0 ) )
+	{
+		pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block was merged with the one before it, that block is already
+	linked in. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const xHeapRegion * const pxHeapRegions )
+{
+const xHeapRegion *pxRegion;
+xBlockLink *pxFirstFreeBlockInRegion, *pxPreviousEnd = NULL;
+size_t xAddress, xEndAddress;
+
+	/* Regions must be given in ascending address order and the array ends
+	with a region of size zero.  Calling this twice is not supported. */
+	configASSERT( pxEnd == NULL );
+
+	xStart.xBlockSize = ( size_t ) 0;
+	xStart.pxNextFreeBlock = NULL;
+
+	for( pxRegion = pxHeapRegions; pxRegion->xSizeInBytes > 0; pxRegion++ )
+	{
+		xAddress = ( size_t ) pxRegion->pucStartAddress;
+		xEndAddress = xAddress + pxRegion->xSizeInBytes;
+
+		/* Align both ends, the marker goes at the aligned end. */
+		xAddress = ( xAddress + portBYTE_ALIGNMENT_MASK ) & ~( size_t ) portBYTE_ALIGNMENT_MASK;
+		xEndAddress = ( xEndAddress - heapSTRUCT_SIZE ) & ~( size_t ) portBYTE_ALIGNMENT_MASK;
+
+		if( ( xEndAddress <= xAddress ) || ( ( xEndAddress - xAddress ) < heapMINIMUM_BLOCK_SIZE ) )
+		{
+			continue;
+		}
+
+		/* To start with the region holds a single free block followed by
+		its end marker. */
+		pxFirstFreeBlockInRegion = ( void * ) xAddress;
+		pxFirstFreeBlockInRegion->xBlockSize = xEndAddress - xAddress;
+
+		pxEnd = ( void * ) xEndAddress;
+		pxEnd->xBlockSize = ( size_t ) 0;
+		pxEnd->pxNextFreeBlock = NULL;
+		pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd;
+
+		/* Chain the region onto the end of the previous one. */
+		if( pxPreviousEnd == NULL )
+		{
+			xStart.pxNextFreeBlock = pxFirstFreeBlockInRegion;
+		}
+		else
+		{
+			configASSERT( pxPreviousEnd < pxFirstFreeBlockInRegion );
+			pxPreviousEnd->pxNextFreeBlock = pxFirstFreeBlockInRegion;
+		}
+		pxPreviousEnd = pxEnd;
+
+		xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+	}
+
+	xFreeBytesRemaining = xTotalHeapSize;
+
+	/* At least one region must have been usable. */
+	configASSERT( pxEnd != NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+xHeapRegion xRegions[ 2 ];
+
+	xRegions[ 0 ].pucStartAddress = _sheap;
+	xRegions[ 0 ].xSizeInBytes = ( size_t ) ( _eheap - _sheap );
+	xRegions[ 1 ].pucStartAddress = NULL;
+	xRegions[ 1 ].xSizeInBytes = ( size_t ) 0;
+
+	vPortDefineHeapRegions( xRegions );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc and the application has not
+		defined its own regions, use the one from the linker script. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+
+		/* The wanted size is increased so it can contain a xBlockLink
+		structure in addition to the requested amount of bytes. */
+		if( xWantedSize > 0 )
+		{
+			xWantedSize += heapSTRUCT_SIZE;
+
+			/* Ensure that blocks are always aligned to the required number of bytes. */
+			if( xWantedSize & portBYTE_ALIGNMENT_MASK )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			}
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* Blocks are stored in address order, take the first one that is
+			large enough.  Region markers have a size of zero so are passed
+			over. */
+			pxPreviousBlock = &xStart;
+			pxBlock = xStart.pxNextFreeBlock;
+			while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+			{
+				pxPreviousBlock = pxBlock;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+
+			/* If we found the end marker then a block of adequate size was not found. */
+			if( pxBlock != pxEnd )
+			{
+				/* Return the memory space - jumping over the xBlockLink structure
+				at its start. */
+				pvReturn = ( void * ) ( ( ( unsigned char * ) pxBlock ) + heapSTRUCT_SIZE );
+
+				/* This block is being returned for use so must be taken out of
+				the list of free blocks. */
+				pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+				/* If the block is larger than required it can be split into
+				two.  The remainder takes the block's place in the list, which
+				keeps the list in address order. */
+				if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+				{
+					pxNewBlockLink = ( void * ) ( ( ( unsigned char * ) pxBlock ) + xWantedSize );
+					pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+					pxPreviousBlock->pxNextFreeBlock = pxNewBlockLink;
+					pxBlock->xBlockSize = xWantedSize;
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	traceMALLOC( pvReturn, xWantedSize );
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink;
+
+	if( pv )
+	{
+		/* The memory being freed will have an xBlockLink structure immediately
+		before it. */
+		puc -= heapSTRUCT_SIZE;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+		traceFREE( pv, pxLink->xBlockSize );
+
+		vTaskSuspendAll();
+		{
+			xFreeBytesRemaining += pxLink->xBlockSize;
+			prvInsertBlockIntoFreeList( pxLink );
+		}
+		xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink, *pxIterator, *pxNext, *pxNewBlockLink;
+size_t xNewSize;
+void *pvReturn = NULL;
+
+	if( pv == NULL )
+	{
+		return pvPortMalloc( xWantedSize );
+	}
+
+	if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+		return NULL;
+	}
+
+	puc -= heapSTRUCT_SIZE;
+	pxLink = ( void * ) puc;
+
+	xNewSize = ( xWantedSize + heapSTRUCT_SIZE + portBYTE_ALIGNMENT_MASK ) & ~( size_t ) portBYTE_ALIGNMENT_MASK;
+
+	vTaskSuspendAll();
+	{
+		if( xNewSize <= pxLink->xBlockSize )
+		{
+			/* Shrinking, or growing into the alignment padding. */
+			pvReturn = pv;
+		}
+		else
+		{
+			/* Grow into the following block if it is free and big enough,
+			instead of moving.  Region markers have a size of zero so never
+			qualify. */
+			for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxLink; pxIterator = pxIterator->pxNextFreeBlock )
+			{
+				/* There is nothing to do here, just iterate to the right position. */
+			}
+			pxNext = pxIterator->pxNextFreeBlock;
+
+			if( ( ( puc + pxLink->xBlockSize ) == ( unsigned char * ) pxNext ) &&
+				( ( pxLink->xBlockSize + pxNext->xBlockSize ) >= xNewSize ) )
+			{
+				xFreeBytesRemaining -= pxNext->xBlockSize;
+				pxLink->xBlockSize += pxNext->xBlockSize;
+				pxIterator->pxNextFreeBlock = pxNext->pxNextFreeBlock;
+
+				/* What is left over takes the absorbed block's place in the
+				list. */
+				if( ( pxLink->xBlockSize - xNewSize ) > heapMINIMUM_BLOCK_SIZE )
+				{
+					pxNewBlockLink = ( void * ) ( puc + xNewSize );
+					pxNewBlockLink->xBlockSize = pxLink->xBlockSize - xNewSize;
+					pxNewBlockLink->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+					pxIterator->pxNextFreeBlock = pxNewBlockLink;
+					pxLink->xBlockSize = xNewSize;
+					xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+				}
+				pvReturn = pv;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	if( pvReturn == NULL )
+	{
+		/* No room to grow, move the block.  The original is left untouched
+		if that fails. */
+		pvReturn = pvPortMalloc( xWantedSize );
+		if( pvReturn != NULL )
+		{
+			memcpy( pvReturn, pv, pxLink->xBlockSize - heapSTRUCT_SIZE );
+			vPortFree( pv );
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetTotalHeapSize( void )
+{
+	return xTotalHeapSize;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+	{
+	xBlockLink *pxBlock;
+
+		/* The free list is in address order, region markers are skipped. */
+		vTaskSuspendAll();
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( pxBlock->xBlockSize != 0 )
+				{
+					pxCallback( pxBlock, pxBlock->xBlockSize, pvParameter );
+				}
+			}
+		}
+		xTaskResumeAll();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
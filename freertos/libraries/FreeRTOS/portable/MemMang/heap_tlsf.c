@@ -0,0 +1,533 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A Two-Level Segregated Fit implementation of pvPortMalloc() and vPortFree().
+ *
+ * Free blocks are kept in an array of segregated lists indexed by a first
+ * level (power of two size class) and a second level (linear subdivision of
+ * that class).  A bitmap per level records which lists are non-empty, so
+ * finding a suitable block is a couple of count-leading-zeros instructions
+ * instead of a list walk.  Every block records its physical predecessor, so
+ * a freed block is merged with both neighbours immediately.  Both malloc and
+ * free therefore run in bounded time regardless of fragmentation.
+ *
+ * Select it with HEAP_IMPL = heap_tlsf in the Makefile.  See heap_ww.c for
+ * the list based best fit allocator it replaces.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Each first level class is split into 2^tlsfSL_INDEX_COUNT_LOG2 lists. */
+#define tlsfSL_INDEX_COUNT_LOG2	( 4 )
+#define tlsfSL_INDEX_COUNT		( 1 << tlsfSL_INDEX_COUNT_LOG2 )
+
+/* Block sizes are multiples of the port alignment, so blocks smaller than
+tlsfSMALL_BLOCK_SIZE all live in first level 0, one list per size step. */
+#define tlsfALIGN_SIZE_LOG2		( portBYTE_ALIGNMENT == 8 ? 3 : 2 )
+#define tlsfFL_INDEX_SHIFT		( tlsfSL_INDEX_COUNT_LOG2 + tlsfALIGN_SIZE_LOG2 )
+#define tlsfSMALL_BLOCK_SIZE	( ( size_t ) 1 << tlsfFL_INDEX_SHIFT )
+
+/* The largest first level must cover configTOTAL_HEAP_SIZE.  64K covers any
+heap this part can hold. */
+#define tlsfFL_INDEX_MAX		( 16 )
+#define tlsfFL_INDEX_COUNT		( tlsfFL_INDEX_MAX - tlsfFL_INDEX_SHIFT + 1 )
+
+/* Fails to compile if configTOTAL_HEAP_SIZE is too large for tlsfFL_INDEX_MAX
+(the size is a cast expression, so the preprocessor cannot check it). */
+typedef char xTLSFHeapSizeCheck[ ( configTOTAL_HEAP_SIZE < ( ( size_t ) 1 << tlsfFL_INDEX_MAX ) ) ? 1 : -1 ];
+
+/* The low bit of xBlockSize marks a free block, sizes are always aligned so it
+is never part of the size itself. */
+#define tlsfBLOCK_FREE			( ( size_t ) 1 )
+#define tlsfBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~tlsfBLOCK_FREE )
+#define tlsfBLOCK_IS_FREE( pxBlock )	( ( pxBlock )->xBlockSize & tlsfBLOCK_FREE )
+
+/* Block header.  Only pxPrevPhysBlock and xBlockSize exist while a block is
+allocated, the free list links overlay the start of the user area. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPrevPhysBlock;	/*<< The block physically before this one, NULL for the first. */
+	size_t xBlockSize;						/*<< Size including this header, low bit set when free. */
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< Next block in the same segregated list. */
+	struct A_BLOCK_LINK *pxPrevFreeBlock;	/*<< Previous block in the same segregated list. */
+} xBlockLink;
+
+#define heapSTRUCT_SIZE			( ( size_t ) ( ( 2 * sizeof( void * ) + portBYTE_ALIGNMENT_MASK ) & ~portBYTE_ALIGNMENT_MASK ) )
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( ( sizeof( xBlockLink ) + portBYTE_ALIGNMENT_MASK ) & ~portBYTE_ALIGNMENT_MASK ) )
+
+/* Allocate the memory for the heap.  The union is used to force byte
+alignment without using any non-portable code. */
+static union xRTOS_HEAP
+{
+	#if portBYTE_ALIGNMENT == 8
+		volatile portDOUBLE dDummy;
+	#else
+		volatile unsigned long ulDummy;
+	#endif
+	unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+} xHeap;
+
+/* The heap ends with a zero sized allocated block so the physical successor of
+the last real block always exists and is never merged. */
+#define heapUSABLE_SIZE			( ( configTOTAL_HEAP_SIZE - heapSTRUCT_SIZE ) & ~portBYTE_ALIGNMENT_MASK )
+
+static unsigned long ulFLBitmap;
+static unsigned long ulSLBitmap[ tlsfFL_INDEX_COUNT ];
+static xBlockLink *pxFreeBlocks[ tlsfFL_INDEX_COUNT ][ tlsfSL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = heapUSABLE_SIZE;
+
+/* Index of the most and least significant set bit, x must not be zero.  On
+Cortex-M3 both compile to a CLZ (plus RBIT for the latter). */
+#define tlsfFLS( x )			( 31 - __builtin_clz( x ) )
+#define tlsfFFS( x )			( __builtin_ctz( x ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Map a block size to the list it is stored in.
+ */
+#define prvMappingInsert( xSize, pxFL, pxSL )												\
+{																							\
+	if( ( xSize ) < tlsfSMALL_BLOCK_SIZE )													\
+	{																						\
+		*( pxFL ) = 0;																		\
+		*( pxSL ) = ( xSize ) >> tlsfALIGN_SIZE_LOG2;										\
+	}																						\
+	else																					\
+	{																						\
+		*( pxFL ) = tlsfFLS( xSize );														\
+		*( pxSL ) = ( ( xSize ) >> ( *( pxFL ) - tlsfSL_INDEX_COUNT_LOG2 ) ) ^ tlsfSL_INDEX_COUNT; \
+		*( pxFL ) -= tlsfFL_INDEX_SHIFT - 1;												\
+	}																						\
+}
+
+/*
+ * Insert a free block at the head of its segregated list.
+ */
+#define prvInsertBlockIntoFreeList( pxBlockToInsert )										\
+{																							\
+	unsigned long ulFL, ulSL;																\
+	size_t xSize = tlsfBLOCK_SIZE( pxBlockToInsert );										\
+																							\
+	prvMappingInsert( xSize, &ulFL, &ulSL );												\
+	( pxBlockToInsert )->pxPrevFreeBlock = NULL;											\
+	( pxBlockToInsert )->pxNextFreeBlock = pxFreeBlocks[ ulFL ][ ulSL ];					\
+	if( pxFreeBlocks[ ulFL ][ ulSL ] != NULL )												\
+	{																						\
+		pxFreeBlocks[ ulFL ][ ulSL ]->pxPrevFreeBlock = ( pxBlockToInsert );				\
+	}																						\
+	pxFreeBlocks[ ulFL ][ ulSL ] = ( pxBlockToInsert );										\
+	ulFLBitmap |= 1UL << ulFL;																\
+	ulSLBitmap[ ulFL ] |= 1UL << ulSL;														\
+	( pxBlockToInsert )->xBlockSize |= tlsfBLOCK_FREE;										\
+}
+
+/*
+ * Unlink a free block from its segregated list, clearing the bitmaps when the
+ * list becomes empty.
+ */
+#define prvRemoveBlockFromFreeList( pxBlockToRemove )										\
+{																							\
+	unsigned long ulFL, ulSL;																\
+	size_t xSize = tlsfBLOCK_SIZE( pxBlockToRemove );										\
+																							\
+	prvMappingInsert( xSize, &ulFL, &ulSL );												\
+	if( ( pxBlockToRemove )->pxNextFreeBlock != NULL )										\
+	{																						\
+		( pxBlockToRemove )->pxNextFreeBlock->pxPrevFreeBlock = ( pxBlockToRemove )->pxPrevFreeBlock; \
+	}																						\
+	if( ( pxBlockToRemove )->pxPrevFreeBlock != NULL )										\
+	{																						\
+		( pxBlockToRemove )->pxPrevFreeBlock->pxNextFreeBlock = ( pxBlockToRemove )->pxNextFreeBlock; \
+	}																						\
+	else																					\
+	{																						\
+		pxFreeBlocks[ ulFL ][ ulSL ] = ( pxBlockToRemove )->pxNextFreeBlock;				\
+		if( pxFreeBlocks[ ulFL ][ ulSL ] == NULL )											\
+		{																					\
+			ulSLBitmap[ ulFL ] &= ~( 1UL << ulSL );											\
+			if( ulSLBitmap[ ulFL ] == 0 )													\
+			{																				\
+				ulFLBitmap &= ~( 1UL << ulFL );												\
+			}																				\
+		}																					\
+	}																						\
+	( pxBlockToRemove )->xBlockSize &= ~tlsfBLOCK_FREE;										\
+}
+
+#define prvNextPhysBlock( pxBlock )	( ( xBlockLink * ) ( ( ( unsigned char * ) ( pxBlock ) ) + tlsfBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+#define prvHeapInit()																		\
+{																							\
+	xBlockLink *pxFirstFreeBlock, *pxSentinel;												\
+																							\
+	/* To start with there is a single free block that is sized to take up the		\
+	entire heap space, followed by the zero sized sentinel. */							\
+	pxFirstFreeBlock = ( void * ) xHeap.ucHeap;												\
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;												\
+	pxFirstFreeBlock->xBlockSize = heapUSABLE_SIZE;											\
+																							\
+	pxSentinel = prvNextPhysBlock( pxFirstFreeBlock );										\
+	pxSentinel->pxPrevPhysBlock = pxFirstFreeBlock;											\
+	pxSentinel->xBlockSize = 0;																\
+																							\
+	prvInsertBlockIntoFreeList( pxFirstFreeBlock );											\
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Find a free block of at least xWantedSize bytes.  The size is first rounded
+ * up to the next list boundary so that any block in the chosen list fits,
+ * which makes this a good fit rather than a best fit search but keeps it
+ * free of loops.  If that fails the head of the list the exact size maps to
+ * is tried as well, so the last large block can still be handed out whole.
+ */
+static xBlockLink *prvFindSuitableBlock( size_t xWantedSize )
+{
+unsigned long ulFL, ulSL, ulMap;
+size_t xRoundedSize = xWantedSize;
+xBlockLink *pxBlock;
+
+	if( xRoundedSize >= tlsfSMALL_BLOCK_SIZE )
+	{
+		xRoundedSize += ( ( size_t ) 1 << ( tlsfFLS( xRoundedSize ) - tlsfSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	prvMappingInsert( xRoundedSize, &ulFL, &ulSL );
+
+	if( ulFL < tlsfFL_INDEX_COUNT )
+	{
+		/* Any list in this first level at or above the second level index? */
+		ulMap = ulSLBitmap[ ulFL ] & ( ~0UL << ulSL );
+		if( ulMap == 0 )
+		{
+			/* No, take the smallest non-empty larger first level. */
+			ulMap = ulFLBitmap & ( ~0UL << ( ulFL + 1 ) );
+			if( ulMap != 0 )
+			{
+				ulFL = tlsfFFS( ulMap );
+				ulMap = ulSLBitmap[ ulFL ];
+			}
+		}
+
+		if( ulMap != 0 )
+		{
+			ulSL = tlsfFFS( ulMap );
+			return pxFreeBlocks[ ulFL ][ ulSL ];
+		}
+	}
+
+	prvMappingInsert( xWantedSize, &ulFL, &ulSL );
+	pxBlock = pxFreeBlocks[ ulFL ][ ulSL ];
+	if( ( pxBlock != NULL ) && ( tlsfBLOCK_SIZE( pxBlock ) >= xWantedSize ) )
+	{
+		return pxBlock;
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xBlockLink *pxBlock, *pxNewBlockLink;
+static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+			xHeapHasBeenInitialised = pdTRUE;
+		}
+
+		/* The wanted size is increased so it can contain the header in
+		addition to the requested amount of bytes, and so the block can hold
+		the free list links once it is released again. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < heapUSABLE_SIZE ) )
+		{
+			xWantedSize += heapSTRUCT_SIZE;
+
+			/* Ensure that blocks are always aligned to the required number of bytes. */
+			xWantedSize = ( xWantedSize + portBYTE_ALIGNMENT_MASK ) & ~portBYTE_ALIGNMENT_MASK;
+			if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+			{
+				xWantedSize = heapMINIMUM_BLOCK_SIZE;
+			}
+
+			pxBlock = prvFindSuitableBlock( xWantedSize );
+			if( pxBlock != NULL )
+			{
+				prvRemoveBlockFromFreeList( pxBlock );
+
+				/* If the block is larger than required it can be split into two. */
+				if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+				{
+					/* This block is to be split into two.  Create a new block
+					following the number of bytes requested. The void cast is
+					used to prevent byte alignment warnings from the compiler. */
+					pxNewBlockLink = ( void * ) ( ( ( unsigned char * ) pxBlock ) + xWantedSize );
+					pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+					prvNextPhysBlock( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+					pxBlock->xBlockSize = xWantedSize;
+
+					/* Insert the new block into the list of free blocks. */
+					prvInsertBlockIntoFreeList( pxNewBlockLink );
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+				pvReturn = ( void * ) ( ( ( unsigned char * ) pxBlock ) + heapSTRUCT_SIZE );
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	traceMALLOC( pvReturn, xWantedSize );
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink, *pxNeighbour;
+
+	if( pv )
+	{
+		/* The memory being freed will have a header immediately before it. */
+		puc -= heapSTRUCT_SIZE;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+		traceFREE( pv, pxLink->xBlockSize );
+
+		vTaskSuspendAll();
+		{
+			xFreeBytesRemaining += pxLink->xBlockSize;
+
+			/* Merge with the physically preceding block if that is free. */
+			pxNeighbour = pxLink->pxPrevPhysBlock;
+			if( ( pxNeighbour != NULL ) && tlsfBLOCK_IS_FREE( pxNeighbour ) )
+			{
+				prvRemoveBlockFromFreeList( pxNeighbour );
+				pxNeighbour->xBlockSize += pxLink->xBlockSize;
+				pxLink = pxNeighbour;
+			}
+
+			/* And with the following one.  The sentinel is never free. */
+			pxNeighbour = prvNextPhysBlock( pxLink );
+			if( tlsfBLOCK_IS_FREE( pxNeighbour ) )
+			{
+				prvRemoveBlockFromFreeList( pxNeighbour );
+				pxLink->xBlockSize += pxNeighbour->xBlockSize;
+			}
+
+			prvNextPhysBlock( pxLink )->pxPrevPhysBlock = pxLink;
+			prvInsertBlockIntoFreeList( pxLink );
+		}
+		xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink, *pxNext, *pxNewBlockLink;
+size_t xNewSize;
+void *pvReturn = NULL;
+
+	if( pv == NULL )
+	{
+		return pvPortMalloc( xWantedSize );
+	}
+
+	if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+		return NULL;
+	}
+
+	puc -= heapSTRUCT_SIZE;
+	pxLink = ( void * ) puc;
+
+	if( xWantedSize < heapUSABLE_SIZE )
+	{
+		xNewSize = ( xWantedSize + heapSTRUCT_SIZE + portBYTE_ALIGNMENT_MASK ) & ~portBYTE_ALIGNMENT_MASK;
+
+		vTaskSuspendAll();
+		{
+			pxNext = prvNextPhysBlock( pxLink );
+			if( xNewSize <= pxLink->xBlockSize )
+			{
+				/* Shrinking, or growing into the alignment padding. */
+				pvReturn = pv;
+			}
+			else if( tlsfBLOCK_IS_FREE( pxNext ) && ( ( pxLink->xBlockSize + tlsfBLOCK_SIZE( pxNext ) ) >= xNewSize ) )
+			{
+				/* Grow into the following free block instead of moving. */
+				prvRemoveBlockFromFreeList( pxNext );
+				xFreeBytesRemaining -= pxNext->xBlockSize;
+				pxLink->xBlockSize += pxNext->xBlockSize;
+
+				/* Give back what is left over. */
+				if( ( pxLink->xBlockSize - xNewSize ) >= heapMINIMUM_BLOCK_SIZE )
+				{
+					pxNewBlockLink = ( void * ) ( puc + xNewSize );
+					pxNewBlockLink->xBlockSize = pxLink->xBlockSize - xNewSize;
+					pxNewBlockLink->pxPrevPhysBlock = pxLink;
+					prvNextPhysBlock( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+					pxLink->xBlockSize = xNewSize;
+					xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+					prvInsertBlockIntoFreeList( pxNewBlockLink );
+				}
+				else
+				{
+					prvNextPhysBlock( pxLink )->pxPrevPhysBlock = pxLink;
+				}
+				pvReturn = pv;
+			}
+		}
+		xTaskResumeAll();
+	}
+
+	if( pvReturn == NULL )
+	{
+		/* No room to grow, move the block.  The original is left untouched
+		if that fails. */
+		pvReturn = pvPortMalloc( xWantedSize );
+		if( pvReturn != NULL )
+		{
+			memcpy( pvReturn, pv, pxLink->xBlockSize - heapSTRUCT_SIZE );
+			vPortFree( pv );
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetTotalHeapSize( void )
+{
+	return configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+	{
+	xBlockLink *pxBlock;
+
+		/* Walk the physical chain in address order.  It ends at the zero
+		sized sentinel, or straight away if the heap is not set up yet. */
+		vTaskSuspendAll();
+		{
+			for( pxBlock = ( void * ) xHeap.ucHeap; tlsfBLOCK_SIZE( pxBlock ) != 0; pxBlock = prvNextPhysBlock( pxBlock ) )
+			{
+				if( tlsfBLOCK_IS_FREE( pxBlock ) )
+				{
+					pxCallback( pxBlock, tlsfBLOCK_SIZE( pxBlock ), pvParameter );
+				}
+			}
+		}
+		xTaskResumeAll();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
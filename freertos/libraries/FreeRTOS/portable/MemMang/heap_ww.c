@@ -60,12 +60,16 @@
  * management pages of http://www.FreeRTOS.org for more information.
  */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
 task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file provides the general purpose heap, see portable.h. */
+#define portHEAP_IMPLEMENTATION
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -137,7 +141,7 @@ static size_t xFreeBytesRemaining = configTOTAL_HEAP_SIZE;
         /* has a larger size than the block we are inserting. */        \
         for ( pxIterator = &xStartAddr;                                 \
               pxIterator->pxNextAddrBlock != &xEnd &&                   \
-                  (int) pxIterator->pxNextAddrBlock < (int) pxBlockToInsert; \
+                  (portPOINTER_SIZE_TYPE) pxIterator->pxNextAddrBlock < (portPOINTER_SIZE_TYPE) pxBlockToInsert; \
               pxIterator = pxIterator->pxNextAddrBlock )                \
         {                                                               \
             /* There is nothing to do here - just iterate to the correct position. */ \
@@ -227,7 +231,7 @@ void *pvPortMalloc( size_t xWantedSize )
                 pvReturn = ( void * ) ( ( ( unsigned char * ) pxPreviousSizeBlock->pxNextSizeBlock ) +
                                         heapSTRUCT_SIZE );
 
-                while ((int) pxPreviousAddrBlock->pxNextAddrBlock < (int) pxBlock)
+                while ((portPOINTER_SIZE_TYPE) pxPreviousAddrBlock->pxNextAddrBlock < (portPOINTER_SIZE_TYPE) pxBlock)
                     pxPreviousAddrBlock = pxPreviousAddrBlock->pxNextAddrBlock;
 
                 /* This block is being returned for use so must be taken our of the
@@ -258,6 +262,8 @@ void *pvPortMalloc( size_t xWantedSize )
     }
     xTaskResumeAll();
 
+    traceMALLOC( pvReturn, xWantedSize );
+
 #if( configUSE_MALLOC_FAILED_HOOK == 1 )
     {
         if( pvReturn == NULL )
@@ -283,7 +289,9 @@ void *pvPortMalloc( size_t xWantedSize )
         previousBySize = &xStartSize;                                   \
         while (previousBySize->pxNextSizeBlock != NULL) {               \
             successorBySize = previousBySize->pxNextSizeBlock;          \
-            if (successorBySize->xBlockSize >= victim->xBlockSize)      \
+            /* Several blocks may share a size, so match the victim */  \
+            /* itself, not the first block that is big enough. */       \
+            if (successorBySize == victim)                              \
                 break;                                                  \
             previousBySize = successorBySize;                           \
         }                                                               \
@@ -303,16 +311,21 @@ void vPortFree( void *pv )
 
         /* This casting is to keep the compiler from issuing warnings. */
         pxLink = ( void * ) puc;
+        traceFREE( pv, pxLink->xBlockSize );
 
         vTaskSuspendAll();
         {
             xBlockLink *previousPrevious, *previous, *successor;
 
+            /* Account for the block before it is merged with its free */
+            /* neighbours, whose bytes are already counted as free. */
+            xFreeBytesRemaining += pxLink->xBlockSize;
+
             previousPrevious = NULL;
             previous = &xStartAddr;
             while (previous->pxNextAddrBlock != &xEnd) {
                 successor = previous->pxNextAddrBlock;
-                if ((unsigned int) successor >= (unsigned int) pxLink)
+                if ((portPOINTER_SIZE_TYPE) successor >= (portPOINTER_SIZE_TYPE) pxLink)
                     break;
                 previousPrevious = previous;
                 previous = successor;
@@ -332,19 +345,126 @@ void vPortFree( void *pv )
             }
 
             prvInsertBlockIntoFreeList( ( ( xBlockLink * ) pxLink ) );
-            xFreeBytesRemaining += pxLink->xBlockSize;
         }
         xTaskResumeAll();
     }
 }
 /*-----------------------------------------------------------*/
 
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+    unsigned char *puc = ( unsigned char * ) pv;
+    xBlockLink *pxLink, *pxNewBlockLink;
+    size_t xNewSize;
+    void *pvReturn = NULL;
+
+    if ( pv == NULL )
+        return pvPortMalloc( xWantedSize );
+
+    if ( xWantedSize == 0 )
+    {
+        vPortFree( pv );
+        return NULL;
+    }
+
+    puc -= heapSTRUCT_SIZE;
+    pxLink = ( void * ) puc;
+
+    xNewSize = xWantedSize + heapSTRUCT_SIZE;
+    if( xNewSize & portBYTE_ALIGNMENT_MASK )
+    {
+        xNewSize += ( portBYTE_ALIGNMENT - ( xNewSize & portBYTE_ALIGNMENT_MASK ) );
+    }
+
+    vTaskSuspendAll();
+    {
+        xBlockLink *previous, *successor;
+
+        if ( xNewSize <= pxLink->xBlockSize )
+        {
+            /* Shrinking, or growing into the alignment padding. */
+            pvReturn = pv;
+        }
+        else
+        {
+            /* Grow into the block that follows, if it is free and big
+               enough, instead of moving. */
+            previous = &xStartAddr;
+            while ( previous->pxNextAddrBlock != &xEnd &&
+                    ( portPOINTER_SIZE_TYPE ) previous->pxNextAddrBlock < ( portPOINTER_SIZE_TYPE ) pxLink )
+                previous = previous->pxNextAddrBlock;
+            successor = previous->pxNextAddrBlock;
+
+            if ( successor != &xEnd && END_OF_BLOCK(pxLink) == successor &&
+                 pxLink->xBlockSize + successor->xBlockSize >= xNewSize )
+            {
+                prvRemoveFromFreeList(successor, previous);
+                xFreeBytesRemaining -= successor->xBlockSize;
+                pxLink->xBlockSize += successor->xBlockSize;
+
+                /* Give back what is left over. */
+                if ( ( pxLink->xBlockSize - xNewSize ) > heapMINIMUM_BLOCK_SIZE )
+                {
+                    pxNewBlockLink = ( void * ) ( ( ( unsigned char * ) pxLink ) + xNewSize );
+                    pxNewBlockLink->xBlockSize = pxLink->xBlockSize - xNewSize;
+                    pxLink->xBlockSize = xNewSize;
+                    xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                    prvInsertBlockIntoFreeList( pxNewBlockLink );
+                }
+                pvReturn = pv;
+            }
+        }
+    }
+    xTaskResumeAll();
+
+    if ( pvReturn == NULL )
+    {
+        /* No room to grow, move the block.  The original is left untouched
+           if that fails. */
+        pvReturn = pvPortMalloc( xWantedSize );
+        if ( pvReturn != NULL )
+        {
+            memcpy( pvReturn, pv, pxLink->xBlockSize - heapSTRUCT_SIZE );
+            vPortFree( pv );
+        }
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 size_t xPortGetFreeHeapSize( void )
 {
     return xFreeBytesRemaining;
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetTotalHeapSize( void )
+{
+    return configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+void vPortWalkFreeBlocks( pdHEAP_BLOCK_CALLBACK pxCallback, void *pvParameter )
+{
+    xBlockLink *pxBlock;
+
+    /* The address ordered list is empty until the first allocation. */
+    vTaskSuspendAll();
+    {
+        for ( pxBlock = xStartAddr.pxNextAddrBlock;
+              pxBlock != NULL && pxBlock != &xEnd;
+              pxBlock = pxBlock->pxNextAddrBlock )
+            pxCallback( pxBlock, pxBlock->xBlockSize, pvParameter );
+    }
+    xTaskResumeAll();
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
     /* This just exists to keep the linker quiet. */
@@ -0,0 +1,326 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Fixed size block pools in front of the heap implementation.
+ *
+ * Most allocations in this system are small: task and queue control blocks,
+ * line buffers, history entries and command arguments.  Each is served from
+ * the smallest size class that fits, where a class is a static array of equal
+ * sized blocks threaded on a free list.  Allocation and release are a pop or
+ * push under a short critical section, and small blocks no longer chop up the
+ * heap between the large ones (task stacks, queue storage).
+ *
+ * Requests larger than the biggest class, or arriving while their class is
+ * exhausted, fall through to the heap selected by HEAP_IMPL.  vPortFree()
+ * tells the two apart by address.
+ *
+ * Enabled by configUSE_SLAB_ALLOCATOR, see portable.h.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_SLAB_ALLOCATOR == 1 )
+
+/* Block size and block count of each class, smallest first.  Sizes must be
+multiples of portBYTE_ALIGNMENT.  96 bytes holds a task or queue control
+block. */
+#define slabCLASS_COUNT		( 4 )
+#define slabSIZE_0			( 16 )
+#define slabBLOCKS_0		( 16 )
+#define slabSIZE_1			( 32 )
+#define slabBLOCKS_1		( 16 )
+#define slabSIZE_2			( 64 )
+#define slabBLOCKS_2		( 8 )
+#define slabSIZE_3			( 96 )
+#define slabBLOCKS_3		( 10 )
+
+#define slabARENA_SIZE		( slabSIZE_0 * slabBLOCKS_0 + slabSIZE_1 * slabBLOCKS_1 + \
+							  slabSIZE_2 * slabBLOCKS_2 + slabSIZE_3 * slabBLOCKS_3 )
+
+/* A free block holds the link to the next free block of its class. */
+typedef struct A_SLAB_LINK
+{
+	struct A_SLAB_LINK *pxNextFreeBlock;
+} xSlabLink;
+
+typedef struct A_SLAB_CLASS
+{
+	xSlabLink *pxFreeList;				/*< Free blocks of this class. */
+	unsigned char *pucEnd;				/*< First byte past the class' part of the arena. */
+	xSlabStats xStats;
+} xSlabClass;
+
+/* All classes share one arena so ownership is a single range check.  The
+union is used to force byte alignment without using any non-portable code. */
+static union xSLAB_ARENA
+{
+	#if portBYTE_ALIGNMENT == 8
+		volatile portDOUBLE dDummy;
+	#else
+		volatile unsigned long ulDummy;
+	#endif
+	unsigned char ucArena[ slabARENA_SIZE ];
+} xArena;
+
+static xSlabClass xClasses[ slabCLASS_COUNT ] =
+{
+	{ NULL, NULL, { slabSIZE_0, slabBLOCKS_0, 0, 0, 0UL, 0UL } },
+	{ NULL, NULL, { slabSIZE_1, slabBLOCKS_1, 0, 0, 0UL, 0UL } },
+	{ NULL, NULL, { slabSIZE_2, slabBLOCKS_2, 0, 0, 0UL, 0UL } },
+	{ NULL, NULL, { slabSIZE_3, slabBLOCKS_3, 0, 0, 0UL, 0UL } }
+};
+
+#define slabARENA_START		( &xArena.ucArena[ 0 ] )
+#define slabARENA_END		( &xArena.ucArena[ slabARENA_SIZE ] )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Thread every class' blocks onto its free list, lowest address first.
+ */
+static void prvSlabInit( void )
+{
+unsigned char *pucBlock = slabARENA_START;
+xSlabLink **ppxTail;
+unsigned portBASE_TYPE uxClass, uxBlock;
+
+	for( uxClass = 0; uxClass < slabCLASS_COUNT; uxClass++ )
+	{
+		ppxTail = &xClasses[ uxClass ].pxFreeList;
+		for( uxBlock = 0; uxBlock < xClasses[ uxClass ].xStats.uxBlocks; uxBlock++ )
+		{
+			*ppxTail = ( void * ) pucBlock;
+			ppxTail = &( ( *ppxTail )->pxNextFreeBlock );
+			pucBlock += xClasses[ uxClass ].xStats.xBlockSize;
+		}
+		*ppxTail = NULL;
+		xClasses[ uxClass ].pucEnd = pucBlock;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+static portBASE_TYPE xSlabHasBeenInitialised = pdFALSE;
+xSlabClass *pxClass = NULL;
+xSlabLink *pxBlock = NULL;
+unsigned portBASE_TYPE uxClass;
+void *pvReturn;
+
+	if( xSlabHasBeenInitialised == pdFALSE )
+	{
+		vTaskSuspendAll();
+		{
+			if( xSlabHasBeenInitialised == pdFALSE )
+			{
+				prvSlabInit();
+				xSlabHasBeenInitialised = pdTRUE;
+			}
+		}
+		xTaskResumeAll();
+	}
+
+	if( xWantedSize > 0 )
+	{
+		for( uxClass = 0; uxClass < slabCLASS_COUNT; uxClass++ )
+		{
+			if( xWantedSize <= xClasses[ uxClass ].xStats.xBlockSize )
+			{
+				pxClass = &xClasses[ uxClass ];
+				break;
+			}
+		}
+	}
+
+	if( pxClass != NULL )
+	{
+		portENTER_CRITICAL();
+		{
+			pxBlock = pxClass->pxFreeList;
+			if( pxBlock != NULL )
+			{
+				pxClass->pxFreeList = pxBlock->pxNextFreeBlock;
+				pxClass->xStats.ulAllocations++;
+				if( ++pxClass->xStats.uxInUse > pxClass->xStats.uxMaxInUse )
+				{
+					pxClass->xStats.uxMaxInUse = pxClass->xStats.uxInUse;
+				}
+			}
+			else
+			{
+				pxClass->xStats.ulFallbacks++;
+			}
+		}
+		portEXIT_CRITICAL();
+	}
+
+	if( pxBlock != NULL )
+	{
+		traceMALLOC( pxBlock, pxClass->xStats.xBlockSize );
+		return ( void * ) pxBlock;
+	}
+
+	/* The heap's own header overhead is not visible from here, so heap
+	allocations are traced with the requested size. */
+	pvReturn = pvPortHeapMalloc( xWantedSize );
+	traceMALLOC( pvReturn, xWantedSize );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xSlabClass *pxClass;
+xSlabLink *pxBlock;
+
+	if( ( puc < slabARENA_START ) || ( puc >= slabARENA_END ) )
+	{
+		traceFREE( pv, 0 );
+		vPortHeapFree( pv );
+		return;
+	}
+
+	/* The classes are laid out in order, find the one whose range holds the
+	block. */
+	for( pxClass = &xClasses[ 0 ]; puc >= pxClass->pucEnd; pxClass++ )
+	{
+	}
+
+	traceFREE( pv, pxClass->xStats.xBlockSize );
+
+	pxBlock = ( void * ) puc;
+	portENTER_CRITICAL();
+	{
+		pxBlock->pxNextFreeBlock = pxClass->pxFreeList;
+		pxClass->pxFreeList = pxBlock;
+		pxClass->xStats.uxInUse--;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xSlabClass *pxClass;
+void *pvReturn;
+
+	if( pv == NULL )
+	{
+		return pvPortMalloc( xWantedSize );
+	}
+
+	/* Heap blocks are resized by the heap, which can grow them in place. */
+	if( ( puc < slabARENA_START ) || ( puc >= slabARENA_END ) )
+	{
+		return pvPortHeapRealloc( pv, xWantedSize );
+	}
+
+	if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+		return NULL;
+	}
+
+	for( pxClass = &xClasses[ 0 ]; puc >= pxClass->pucEnd; pxClass++ )
+	{
+	}
+
+	/* A pool block is as large as its class, so only outgrowing the class
+	moves it. */
+	if( xWantedSize <= pxClass->xStats.xBlockSize )
+	{
+		return pv;
+	}
+
+	pvReturn = pvPortMalloc( xWantedSize );
+	if( pvReturn != NULL )
+	{
+		memcpy( pvReturn, pv, pxClass->xStats.xBlockSize );
+		vPortFree( pv );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetSlabStats( unsigned portBASE_TYPE uxClass, xSlabStats *pxStats )
+{
+	if( uxClass >= slabCLASS_COUNT )
+	{
+		return pdFALSE;
+	}
+
+	portENTER_CRITICAL();
+	{
+		*pxStats = xClasses[ uxClass ].xStats;
+	}
+	portEXIT_CRITICAL();
+
+	return pdTRUE;
+}
+
+#endif /* configUSE_SLAB_ALLOCATOR */
@@ -135,13 +135,29 @@ typedef struct QueueDefinition
 
 	signed portBASE_TYPE xRxLock;			/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	signed portBASE_TYPE xTxLock;			/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+		struct QueueDefinition *pxQueueSetContainer;	/*< The queue set this queue is a member of, NULL if none. */
+	#endif
 	
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		unsigned char ucQueueNumber;
 		unsigned char ucQueueType;
 	#endif
 
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< pdTRUE if the application supplied the memory, so it must not be freed. */
+	#endif
+
 } xQUEUE;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticQueue in queue.h must mirror xQUEUE, or the storage the
+	application supplies to xQueueCreateStatic() would be the wrong size. */
+	typedef char xStaticQueueSizeCheck[ ( sizeof( xStaticQueue ) == sizeof( xQUEUE ) ) ? 1 : -1 ];
+
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -157,6 +173,7 @@ typedef xQUEUE * xQueueHandle;
  * functions are documented in the API header file.
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueDelete( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
@@ -164,6 +181,7 @@ signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void
 signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex ) PRIVILEGED_FUNCTION;
@@ -178,6 +196,15 @@ void vQueueSetQueueNumber( xQueueHandle pxQueue, unsigned char ucQueueNumber ) P
 unsigned char ucQueueGetQueueType( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue ) PRIVILEGED_FUNCTION;
 xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
 /*
  * Co-routine queue functions differ from task queue functions.  Co-routines are
@@ -250,6 +277,57 @@ static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, port
  * Copies an item out of a queue.
  */
 static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets up a queue, or a mutex, whatever memory it lives in.
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_MUTEXES == 1 )
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	/*
+	 * Copy uxCount items to the back of, or out of the front of, a queue that
+	 * has the space or the items, in at most two memcpy() calls, and update
+	 * uxMessagesWaiting.
+	 */
+	static void prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+	static void prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unblock up to uxCount tasks from an event list of the queue, one for
+	 * each item moved.  Must be called from a critical section or with
+	 * interrupts masked, and only when the queue is not locked.
+	 *
+	 * @return pdTRUE if a task with a priority above the current task was
+	 * unblocked.
+	 */
+	static signed portBASE_TYPE prvUnblockWaitingTasks( xList * const pxEventList, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	#if ( configUSE_ALTERNATIVE_API == 1 )
+		#error configUSE_QUEUE_SETS cannot be used with configUSE_ALTERNATIVE_API
+	#endif
+
+	/*
+	 * Post the handle of a queue that uxCount items were just posted to onto
+	 * the queue set it is a member of, once per item, and unblock tasks
+	 * selecting from the set.  Must be called from a critical section or with
+	 * interrupts masked.  If the set is locked the task that unlocks it does
+	 * the unblocking.
+	 *
+	 * @return pdTRUE if a task with a priority above the current task was
+	 * unblocked.
+	 */
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -338,16 +416,13 @@ xQueueHandle xReturn = NULL;
 			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
 			if( pxNewQueue->pcHead != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				xQueueGenericReset( pxNewQueue, pdTRUE );
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, ucQueueType );
+
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
 				}
-				#endif /* configUSE_TRACE_FACILITY */
+				#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 				traceQUEUE_CREATE( pxNewQueue );
 				xReturn = pxNewQueue;
@@ -366,52 +441,92 @@ xQueueHandle xReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue;
+
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pxStaticQueue != NULL );
+
+		/* Storage must be supplied if, and only if, items have a size. */
+		configASSERT( ( pucQueueStorage != NULL ) == ( uxItemSize != ( unsigned portBASE_TYPE ) 0 ) );
+
+		/* The size of xStaticQueue was checked against xQUEUE when this file
+		was compiled. */
+		pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+		if( pxNewQueue != NULL )
+		{
+			if( uxItemSize == ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* Nothing is copied, but pcHead must not be NULL as that
+				marks a mutex.  Point it at the queue itself, which is never
+				written through it. */
+				pxNewQueue->pcHead = ( signed char * ) pxNewQueue;
+			}
+			else
+			{
+				/* Unlike the heap allocated storage, this does not need the
+				extra byte xQueueGenericCreate() adds, nothing is stored at
+				pcTail. */
+				pxNewQueue->pcHead = ( signed char * ) pucQueueStorage;
+			}
+
+			prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, ucQueueType );
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+			traceQUEUE_CREATE( pxNewQueue );
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
+{
+	/* Remove compiler warnings about unused parameters should
+	configUSE_TRACE_FACILITY not be set to 1. */
+	( void ) ucQueueType;
+
+	/* Initialise the queue members as described above where the
+	queue type is defined. */
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	xQueueGenericReset( pxNewQueue, pdTRUE );
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxNewQueue->ucQueueType = ucQueueType;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+	}
+	#endif /* configUSE_QUEUE_SETS */
+}
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
 	{
 	xQUEUE *pxNewQueue;
 
-		/* Prevent compiler warnings about unused parameters if
-		configUSE_TRACE_FACILITY does not equal 1. */
-		( void ) ucQueueType;
-
 		/* Allocate the new queue structure. */
 		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 		if( pxNewQueue != NULL )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
-
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->pcReadFrom = NULL;
-
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
-			pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
-
-			#if ( configUSE_TRACE_FACILITY == 1 )
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
-				pxNewQueue->ucQueueType = ucQueueType;
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
 			}
 			#endif
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
-
-			traceCREATE_MUTEX( pxNewQueue );
-
-			/* Start with the semaphore in the expected state. */
-			xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
 		}
 		else
 		{
@@ -425,6 +540,80 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue;
+
+		configASSERT( pxStaticQueue != NULL );
+
+		/* The size of xStaticQueue was checked against xQUEUE when this file
+		was compiled. */
+		pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES and configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType )
+	{
+		/* Prevent compiler warnings about unused parameters if
+		configUSE_TRACE_FACILITY does not equal 1. */
+		( void ) ucQueueType;
+
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
+		pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxNewQueue->ucQueueType = ucQueueType;
+		}
+		#endif
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			pxNewQueue->pxQueueSetContainer = NULL;
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		traceCREATE_MUTEX( pxNewQueue );
+
+		/* Start with the semaphore in the expected state. */
+		xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	void* xQueueGetMutexHolder( xQueueHandle xSemaphore )
@@ -592,19 +781,46 @@ xTimeOutType xTimeOut;
 				traceQUEUE_SEND( pxQueue );
 				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-				/* If there was a task waiting for data to arrive on the
-				queue then unblock it now. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				#if ( configUSE_QUEUE_SETS == 1 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						/* The unblocked task has a priority higher than
-						our own so yield immediately.  Yes it is ok to do
-						this from within the critical section - the kernel
-						takes care of that. */
-						portYIELD_WITHIN_API();
+						/* The queue is read by whichever task selects it
+						from its set, so it is that task that is
+						unblocked. */
+						if( prvNotifyQueueSetContainer( pxQueue, xCopyPosition, ( unsigned portBASE_TYPE ) 1U ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+					else
+					{
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+							{
+								portYIELD_WITHIN_API();
+							}
+						}
+					}
+				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					/* If there was a task waiting for data to arrive on the
+					queue then unblock it now. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							/* The unblocked task has a priority higher than
+							our own so yield immediately.  Yes it is ok to do
+							this from within the critical section - the kernel
+							takes care of that. */
+							portYIELD_WITHIN_API();
+						}
 					}
 				}
+				#endif /* configUSE_QUEUE_SETS */
 
 				taskEXIT_CRITICAL();
 
@@ -921,20 +1137,45 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 			be done when the queue is unlocked later. */
 			if( pxQueue->xTxLock == queueUNLOCKED )
 			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				#if ( configUSE_QUEUE_SETS == 1 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxQueue, xCopyPosition, ( unsigned portBASE_TYPE ) 1U ) == pdTRUE )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+					else
 					{
-						/* The task waiting has a higher priority so record that a
-						context	switch is required. */
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							{
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+						}
 					}
 				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record that a
+							context	switch is required. */
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
 			}
 			else
 			{
 				/* Increment the lock count so the task that unlocks the queue
-				knows that data was posted while it was locked. */
+				knows that data was posted while it was locked.  It also
+				posts to the queue set, if the queue is a member of one. */
 				++( pxQueue->xTxLock );
 			}
 
@@ -1157,6 +1398,437 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+	xTimeOutType xTimeOut;
+	unsigned portBASE_TYPE uxSent = ( unsigned portBASE_TYPE ) 0U, uxCount;
+
+		configASSERT( pxQueue );
+		configASSERT( pvItems );
+
+		/* Semaphores and mutexes have no items to copy. */
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		/* This function relaxes the coding standard somewhat to allow return
+		statements within the function itself, as xQueueGenericSend() does. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Copy as many of the remaining items as there is room for,
+				and unblock as many receivers as there are new items. */
+				uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+				if( uxCount > uxItemCount - uxSent )
+				{
+					uxCount = uxItemCount - uxSent;
+				}
+
+				if( uxCount > ( unsigned portBASE_TYPE ) 0U )
+				{
+					traceQUEUE_SEND( pxQueue );
+					prvCopyItemsToQueue( pxQueue, ( const signed char * ) pvItems + ( uxSent * pxQueue->uxItemSize ), uxCount );
+					uxSent += uxCount;
+
+					#if ( configUSE_QUEUE_SETS == 1 )
+					{
+						if( pxQueue->pxQueueSetContainer != NULL )
+						{
+							/* One handle per item, as if each had been sent
+							on its own. */
+							if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK, uxCount ) == pdTRUE )
+							{
+								portYIELD_WITHIN_API();
+							}
+						}
+						else
+						{
+							if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount ) != pdFALSE )
+							{
+								portYIELD_WITHIN_API();
+							}
+						}
+					}
+					#else /* configUSE_QUEUE_SETS */
+					{
+						if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount ) != pdFALSE )
+						{
+							/* As in xQueueGenericSend(), the yield is taken
+							when the critical section is left. */
+							portYIELD_WITHIN_API();
+						}
+					}
+					#endif /* configUSE_QUEUE_SETS */
+				}
+
+				if( ( uxSent == uxItemCount ) || ( xTicksToWait == ( portTickType ) 0 ) )
+				{
+					/* Everything sent, or no more time to wait for space. */
+					taskEXIT_CRITICAL();
+
+					if( uxSent == ( unsigned portBASE_TYPE ) 0U )
+					{
+						traceQUEUE_SEND_FAILED( pxQueue );
+					}
+					return uxSent;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* The queue is full, block for space as xQueueGenericSend()
+			does. */
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired.  Go round once more without
+				blocking to send whatever there is room for by now. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				xTicksToWait = ( portTickType ) 0;
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItems, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	unsigned portBASE_TYPE uxCount, uxSavedInterruptStatus;
+
+		configASSERT( pxQueue );
+		configASSERT( pvItems );
+		configASSERT( pxHigherPriorityTaskWoken );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			if( uxCount > uxItemCount )
+			{
+				uxCount = uxItemCount;
+			}
+
+			if( uxCount > ( unsigned portBASE_TYPE ) 0U )
+			{
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+				prvCopyItemsToQueue( pxQueue, ( const signed char * ) pvItems, uxCount );
+
+				/* If the queue is locked the task that unlocks it unblocks
+				the receivers, one per item counted in xTxLock. */
+				if( pxQueue->xTxLock == queueUNLOCKED )
+				{
+					#if ( configUSE_QUEUE_SETS == 1 )
+					{
+						if( pxQueue->pxQueueSetContainer != NULL )
+						{
+							if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK, uxCount ) == pdTRUE )
+							{
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+						}
+						else
+						{
+							if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount ) != pdFALSE )
+							{
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+						}
+					}
+					#else /* configUSE_QUEUE_SETS */
+					{
+						if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount ) != pdFALSE )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+					#endif /* configUSE_QUEUE_SETS */
+				}
+				else
+				{
+					pxQueue->xTxLock += ( signed portBASE_TYPE ) uxCount;
+				}
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return uxCount;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+	xTimeOutType xTimeOut;
+	unsigned portBASE_TYPE uxCount;
+
+		configASSERT( pxQueue );
+		configASSERT( pvBuffer );
+		configASSERT( uxMaxItems > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Take everything there is, up to uxMaxItems, and unblock
+				as many senders as there are free spaces. */
+				uxCount = pxQueue->uxMessagesWaiting;
+				if( uxCount > uxMaxItems )
+				{
+					uxCount = uxMaxItems;
+				}
+
+				if( uxCount > ( unsigned portBASE_TYPE ) 0U )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+					prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxCount );
+
+					if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxCount ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					taskEXIT_CRITICAL();
+					return uxCount;
+				}
+				else
+				{
+					if( xTicksToWait == ( portTickType ) 0 )
+					{
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return ( unsigned portBASE_TYPE ) 0U;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return ( unsigned portBASE_TYPE ) 0U;
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken )
+	{
+	unsigned portBASE_TYPE uxCount, uxSavedInterruptStatus;
+
+		configASSERT( pxQueue );
+		configASSERT( pvBuffer );
+		configASSERT( pxTaskWoken );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			uxCount = pxQueue->uxMessagesWaiting;
+			if( uxCount > uxMaxItems )
+			{
+				uxCount = uxMaxItems;
+			}
+
+			if( uxCount > ( unsigned portBASE_TYPE ) 0U )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxCount );
+
+				if( pxQueue->xRxLock == queueUNLOCKED )
+				{
+					if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxCount ) != pdFALSE )
+					{
+						*pxTaskWoken = pdTRUE;
+					}
+				}
+				else
+				{
+					pxQueue->xRxLock += ( signed portBASE_TYPE ) uxCount;
+				}
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return uxCount;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+		/* A set is a queue of the handles of its members. */
+		return xQueueGenericCreate( uxEventQueueLength, sizeof( xQUEUE * ), queueQUEUE_TYPE_BASE );
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn = pdFAIL;
+
+		configASSERT( xQueueOrSemaphore );
+		configASSERT( xQueueSet );
+
+		taskENTER_CRITICAL();
+		{
+			/* Items already in the queue have no handle in the set, and a
+			mutex must be taken by the task that will give it back. */
+			if( ( xQueueOrSemaphore->pxQueueSetContainer == NULL ) &&
+				( xQueueOrSemaphore->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U ) &&
+				( xQueueOrSemaphore->uxQueueType != queueQUEUE_IS_MUTEX ) &&
+				( xQueueOrSemaphore != xQueueSet ) )
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = xQueueSet;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn = pdFAIL;
+
+		configASSERT( xQueueOrSemaphore );
+
+		taskENTER_CRITICAL();
+		{
+			/* An item left in the queue would leave its handle in the set. */
+			if( ( xQueueOrSemaphore->pxQueueSetContainer == xQueueSet ) &&
+				( xQueueOrSemaphore->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = NULL;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xTicksToWait )
+	{
+	xQueueHandle xReturn = NULL;
+
+		( void ) xQueueGenericReceive( xQueueSet, &xReturn, xTicksToWait, pdFALSE );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet )
+	{
+	xQueueHandle xReturn = NULL;
+	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Taking a handle out of a set never makes room a task is waiting
+		for, nothing is ever blocked sending to a set. */
+		( void ) xQueueReceiveFromISR( xQueueSet, &xReturn, &xHigherPriorityTaskWoken );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue )
 {
 unsigned portBASE_TYPE uxReturn;
@@ -1189,8 +1861,22 @@ void vQueueDelete( xQueueHandle pxQueue )
 
 	traceQUEUE_DELETE( pxQueue );
 	vQueueUnregisterQueue( pxQueue );
-	vPortFree( pxQueue->pcHead );
-	vPortFree( pxQueue );
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* Memory supplied by the application is left alone. */
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxQueue->pcHead );
+			vPortFree( pxQueue );
+		}
+	}
+	#else
+	{
+		vPortFree( pxQueue->pcHead );
+		vPortFree( pxQueue );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -1276,6 +1962,144 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	static void prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount )
+	{
+	unsigned portBASE_TYPE uxBytes = uxCount * pxQueue->uxItemSize, uxFirst;
+
+		/* Up to the end of the storage area, then the rest from its start.
+		The storage holds a whole number of items so the split falls between
+		two items. */
+		uxFirst = ( unsigned portBASE_TYPE ) ( pxQueue->pcTail - pxQueue->pcWriteTo );
+		if( uxFirst > uxBytes )
+		{
+			uxFirst = uxBytes;
+		}
+
+		memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, ( unsigned ) uxFirst );
+
+		if( uxBytes > uxFirst )
+		{
+			memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItems + uxFirst ), ( unsigned ) ( uxBytes - uxFirst ) );
+			pxQueue->pcWriteTo = pxQueue->pcHead + ( uxBytes - uxFirst );
+		}
+		else
+		{
+			pxQueue->pcWriteTo += uxBytes;
+			if( pxQueue->pcWriteTo >= pxQueue->pcTail )
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+		}
+
+		pxQueue->uxMessagesWaiting += uxCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount )
+	{
+	unsigned portBASE_TYPE uxBytes = uxCount * pxQueue->uxItemSize, uxFirst;
+	signed char *pcFirst;
+
+		/* pcReadFrom points to the last item read, the next one follows
+		it. */
+		pcFirst = pxQueue->pcReadFrom + pxQueue->uxItemSize;
+		if( pcFirst >= pxQueue->pcTail )
+		{
+			pcFirst = pxQueue->pcHead;
+		}
+
+		uxFirst = ( unsigned portBASE_TYPE ) ( pxQueue->pcTail - pcFirst );
+		if( uxFirst > uxBytes )
+		{
+			uxFirst = uxBytes;
+		}
+
+		memcpy( ( void * ) pcBuffer, ( const void * ) pcFirst, ( unsigned ) uxFirst );
+
+		if( uxBytes > uxFirst )
+		{
+			memcpy( ( void * ) ( pcBuffer + uxFirst ), ( const void * ) pxQueue->pcHead, ( unsigned ) ( uxBytes - uxFirst ) );
+			pxQueue->pcReadFrom = pxQueue->pcHead + ( uxBytes - uxFirst ) - pxQueue->uxItemSize;
+		}
+		else
+		{
+			pxQueue->pcReadFrom = pcFirst + uxBytes - pxQueue->uxItemSize;
+		}
+
+		pxQueue->uxMessagesWaiting -= uxCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	static signed portBASE_TYPE prvUnblockWaitingTasks( xList * const pxEventList, unsigned portBASE_TYPE uxCount )
+	{
+	signed portBASE_TYPE xYieldRequired = pdFALSE;
+
+		/* A task unblocked here may still find the queue empty, or full, if
+		another one gets there first.  It then blocks again, as it would
+		after a single item call. */
+		while( ( uxCount > ( unsigned portBASE_TYPE ) 0U ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+		{
+			if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			--uxCount;
+		}
+
+		return xYieldRequired;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition, unsigned portBASE_TYPE uxCount )
+	{
+	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	signed portBASE_TYPE xReturn = pdFALSE;
+
+		configASSERT( pxQueueSetContainer );
+
+		while( uxCount > ( unsigned portBASE_TYPE ) 0U )
+		{
+			/* The set is as long as all its members together, so it can
+			only be full if that rule was broken. */
+			configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+			if( pxQueueSetContainer->uxMessagesWaiting >= pxQueueSetContainer->uxLength )
+			{
+				break;
+			}
+
+			traceQUEUE_SEND( pxQueueSetContainer );
+			prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, xCopyPosition );
+
+			if( pxQueueSetContainer->xTxLock == queueUNLOCKED )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						xReturn = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				++( pxQueueSetContainer->xTxLock );
+			}
+
+			--uxCount;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( xQueueHandle pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -1289,6 +2113,23 @@ static void prvUnlockQueue( xQueueHandle pxQueue )
 		/* See if data was added to the queue while it was locked. */
 		while( pxQueue->xTxLock > queueLOCKED_UNMODIFIED )
 		{
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				/* Each item posted to a member of a set while it was locked
+				still has to be posted to the set. */
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK, ( unsigned portBASE_TYPE ) 1U ) == pdTRUE )
+					{
+						vTaskMissedYield();
+					}
+
+					--( pxQueue->xTxLock );
+					continue;
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
 			/* Data was posted while the queue was locked.  Are any tasks
 			blocked waiting for data to become available? */
 			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
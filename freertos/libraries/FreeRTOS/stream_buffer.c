@@ -0,0 +1,661 @@
+/*
+    FreeRTOS V7.1.1 - Copyright (C) 2012 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?                                      *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+
+    http://www.FreeRTOS.org - Documentation, training, latest information,
+    license and contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool.
+
+    Real Time Engineers ltd license FreeRTOS to High Integrity Systems, who sell
+    the code with commercial support, indemnification, and middleware, under
+    the OpenRTOS brand: http://www.OpenRTOS.com.  High Integrity Systems also
+    provide a safety engineered and independently SIL3 certified version under
+    the SafeRTOS brand: http://www.SafeRTOS.com.
+*/
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include stream buffer functionality.  This #if is closed at the very bottom
+of this file.  If you want to include stream and message buffers then ensure
+configUSE_STREAM_BUFFERS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_STREAM_BUFFERS == 1 )
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_STREAM_BUFFERS requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/* Bits used in ucFlags. */
+#define sbFLAGS_IS_MESSAGE_BUFFER		( ( unsigned char ) 1U )
+
+/* Bytes stored in front of each message in a message buffer. */
+#define sbBYTES_TO_STORE_MESSAGE_LENGTH	( sizeof( size_t ) )
+
+/* The definition of the stream buffer itself.  Only the writer moves xHead
+and only the reader moves xTail, and each does so after the bytes have been
+copied, so neither needs to lock the other out of the buffer.  Only the task
+handles of a waiting writer or reader are protected by critical sections. */
+typedef struct xSTREAM_BUFFER
+{
+	volatile size_t xTail;					/*<< Index of the next byte to read. */
+	volatile size_t xHead;					/*<< Index of the next byte to write. */
+	size_t xLength;							/*<< Size of pucBuffer, one more than the capacity so that a full buffer can be told apart from an empty one. */
+	size_t xTriggerLevelBytes;				/*<< Bytes that must be in the buffer before a waiting reader is woken. */
+	volatile xTaskHandle xTaskWaitingToReceive;	/*<< The reader blocked on the buffer, if any. */
+	volatile xTaskHandle xTaskWaitingToSend;	/*<< The writer blocked on the buffer, if any. */
+	unsigned char *pucBuffer;				/*<< The storage, allocated directly after this structure. */
+	unsigned char ucFlags;
+} xSTREAM_BUFFER;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The number of bytes in the buffer, lengths of messages included.
+ */
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes into, or out of, the circular storage starting at index
+ * xIndex, in at most two memcpy() calls.  Return the index following the last
+ * byte copied.  Neither moves xHead or xTail.
+ */
+static size_t prvWriteBytesToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount, size_t xIndex ) PRIVILEGED_FUNCTION;
+static size_t prvReadBytesFromBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount, size_t xIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write as much of pvTxData as the stream or message semantics allow, given
+ * xSpace bytes of space, then publish it by moving xHead.  Returns the number
+ * of data bytes written.
+ */
+static size_t prvWriteMessageToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t xSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * Read up to xBufferLengthBytes bytes, or the next whole message, from a
+ * buffer holding xBytesAvailable bytes, then release the space by moving
+ * xTail.  Returns the number of data bytes read.
+ */
+static size_t prvReadMessageFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wake the task whose handle is held in *pxWaitingTask, if there is one, and
+ * clear the handle.
+ */
+static void prvNotifyWaitingTask( volatile xTaskHandle *pxWaitingTask ) PRIVILEGED_FUNCTION;
+static void prvNotifyWaitingTaskFromISR( volatile xTaskHandle *pxWaitingTask, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer )
+{
+xSTREAM_BUFFER *pxStreamBuffer;
+
+	if( xIsMessageBuffer != pdFALSE )
+	{
+		/* There must be room for at least a one byte message. */
+		configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+	}
+	configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+	/* A trigger level of 0 would wake a reader with nothing to read. */
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	/* The control structure and the storage are allocated in one block, the
+	storage being one byte larger than the capacity. */
+	pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes + ( size_t ) 1 );
+
+	if( pxStreamBuffer != NULL )
+	{
+		memset( ( void * ) pxStreamBuffer, 0x00, sizeof( xSTREAM_BUFFER ) );
+		pxStreamBuffer->pucBuffer = ( unsigned char * ) ( pxStreamBuffer + 1 );
+		pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+
+		if( xIsMessageBuffer != pdFALSE )
+		{
+			pxStreamBuffer->ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+		}
+
+		traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+	}
+
+	return ( xStreamBufferHandle ) pxStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
+
+	vPortFree( ( void * ) pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		/* A blocked task would be left waiting for a change that already
+		happened, or that never will. */
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	if( xTriggerLevel < pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvBytesInBuffer( ( xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	return ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferNextMessageLengthBytes( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xLength = ( size_t ) 0;
+
+	configASSERT( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( unsigned char ) 0 )
+	{
+		if( prvBytesInBuffer( pxStreamBuffer ) >= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( unsigned char * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+		}
+	}
+	else
+	{
+		xLength = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn, xSpace, xRequiredSpace = xDataLengthBytes;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( unsigned char ) 0 )
+	{
+		/* A message that can never fit must not wait for space. */
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		configASSERT( xRequiredSpace < pxStreamBuffer->xLength );
+	}
+	else if( xRequiredSpace >= pxStreamBuffer->xLength )
+	{
+		/* Wait for no more than an empty buffer, the rest of the stream is
+		then the caller's to write again. */
+		xRequiredSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+	}
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* The handle is set within the same critical section as the space
+			is checked, so a read that frees space either happens before the
+			check or sees the handle. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Only one task may write at a time. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xSpace >= xRequiredSpace )
+			{
+				break;
+			}
+
+			/* The notification carries no value.  A wake up that does not
+			come from the reader, or a notification left pending from an
+			earlier call, only costs another pass round this loop. */
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+
+	xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xStreamBufferSpacesAvailable( xStreamBuffer ) );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceivedLength = ( size_t ) 0, xBytesAvailable, xTail;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable == ( size_t ) 0 )
+				{
+					/* Only one task may read at a time. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable != ( size_t ) 0 )
+			{
+				break;
+			}
+
+			/* Woken once the trigger level is reached, or spuriously as in
+			xStreamBufferSend(). */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+
+	/* Messages are published whole, so a message buffer holding any bytes
+	holds at least one complete message. */
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( xBytesAvailable != ( size_t ) 0 )
+	{
+		xTail = pxStreamBuffer->xTail;
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+
+		if( pxStreamBuffer->xTail != xTail )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+			prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToSend ) );
+		}
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceivedLength = ( size_t ) 0, xBytesAvailable, xTail;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( xBytesAvailable != ( size_t ) 0 )
+	{
+		xTail = pxStreamBuffer->xTail;
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+
+		if( pxStreamBuffer->xTail != xTail )
+		{
+			traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+			prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToSend ), pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xCount;
+
+	/* xHead and xTail are each read once, either may move underneath. */
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirstLength;
+
+	/* Up to the end of the storage, then the rest from the start. */
+	xFirstLength = pxStreamBuffer->xLength - xIndex;
+	if( xFirstLength > xCount )
+	{
+		xFirstLength = xCount;
+	}
+
+	memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), ( const void * ) pucData, xFirstLength );
+
+	if( xCount > xFirstLength )
+	{
+		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+	}
+
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirstLength;
+
+	xFirstLength = pxStreamBuffer->xLength - xIndex;
+	if( xFirstLength > xCount )
+	{
+		xFirstLength = xCount;
+	}
+
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), xFirstLength );
+
+	if( xCount > xFirstLength )
+	{
+		memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirstLength );
+	}
+
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteMessageToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t xSpace )
+{
+size_t xHead = pxStreamBuffer->xHead;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( unsigned char ) 0 )
+	{
+		/* All or nothing. */
+		if( xSpace >= xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const unsigned char * ) &xDataLengthBytes, sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+		}
+		else
+		{
+			xDataLengthBytes = ( size_t ) 0;
+		}
+	}
+	else if( xDataLengthBytes > xSpace )
+	{
+		/* As much as fits. */
+		xDataLengthBytes = xSpace;
+	}
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes, xHead );
+
+		/* The reader sees the new bytes, and the length in front of them,
+		only once xHead moves. */
+		pxStreamBuffer->xHead = xHead;
+	}
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessageFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t xBytesAvailable )
+{
+size_t xTail = pxStreamBuffer->xTail, xCount;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( unsigned char ) 0 )
+	{
+		configASSERT( xBytesAvailable >= sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( unsigned char * ) &xCount, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+	}
+	else
+	{
+		xCount = xBytesAvailable;
+		if( xCount > xBufferLengthBytes )
+		{
+			xCount = xBufferLengthBytes;
+		}
+	}
+
+	if( xCount <= xBufferLengthBytes )
+	{
+		if( xCount > ( size_t ) 0 )
+		{
+			xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( unsigned char * ) pvRxData, xCount, xTail );
+		}
+
+		/* The space is only handed back to the writer once the bytes have
+		been copied out. */
+		pxStreamBuffer->xTail = xTail;
+	}
+	else
+	{
+		/* The message does not fit, leave it where it is. */
+		xCount = ( size_t ) 0;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTask( volatile xTaskHandle *pxWaitingTask )
+{
+	taskENTER_CRITICAL();
+	{
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotify( *pxWaitingTask, 0UL, eNoAction );
+			*pxWaitingTask = NULL;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTaskFromISR( volatile xTaskHandle *pxWaitingTask, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotifyFromISR( *pxWaitingTask, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+			*pxWaitingTask = NULL;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include stream buffer functionality.  If you want to include stream and
+message buffers then ensure configUSE_STREAM_BUFFERS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_STREAM_BUFFERS == 1 */
@@ -77,6 +77,7 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "deferred.h"
 #include "StackMacros.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -86,6 +87,60 @@ task.h is included from an application file. */
  */
 #define tskIDLE_STACK_SIZE	configMINIMAL_STACK_SIZE
 
+/*
+ * While a task waits on an unordered event list (event groups) its event list
+ * item value holds what it is waiting for rather than its priority.  This bit
+ * marks the value as in use so priority changes leave it alone.
+ */
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
+	#else
+		#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
+	#endif
+
+	#define taskEVENT_LIST_ITEM_VALUE_IS_FREE( pxTCB ) ( ( listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+
+#else
+
+	#define taskEVENT_LIST_ITEM_VALUE_IS_FREE( pxTCB ) ( pdTRUE )
+
+#endif
+
+/*
+ * Notification state of a task, see xTaskNotifyWait().
+ */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	typedef enum
+	{
+		eNotWaitingNotification = 0,
+		eWaitingNotification,
+		eNotified
+	} eNotifyValue;
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Periodic task state, allocated by the first xTaskSetPeriodic() on a task
+	 * so that other tasks only pay for the pointer to it in their TCB.
+	 */
+	typedef struct tskPeriodicState
+	{
+		portTickType xPeriod;					/*< Ticks between releases. */
+		portTickType xRelativeDeadline;			/*< Ticks from a release to the deadline of its job. */
+		portTickType xRelease;					/*< Tick count at which the current job was released. */
+		portTickType xAbsoluteDeadline;			/*< Deadline of the current job, orders the ready list of configEDF_PRIORITY. */
+		unsigned long ulJobs;					/*< Jobs completed with vTaskWaitForNextPeriod(). */
+		unsigned long ulDeadlineMisses;			/*< Jobs completed after their deadline. */
+		portTickType xWorstResponse;			/*< Longest time from a release to completion. */
+	} tskPERIODIC;
+
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated to each task,
  * and stores the context of the task.
@@ -129,8 +184,38 @@ typedef struct tskTaskControlBlock
 		unsigned long ulRunTimeCounter;		/*< Used for calculating how much CPU time each task is utilising. */
 	#endif
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value sent by the last notification(s), see xTaskNotify(). */
+		volatile eNotifyValue eNotifyState;		/*< Whether the task waits for, or has received, a notification. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Which of the TCB and stack the application supplied, see prvDeleteTCB(). */
+	#endif
+
+	#if ( INCLUDE_vTaskWalkStacks == 1 )
+		unsigned short usStackDepth;			/*< The depth the stack was created with, in words, reported by vTaskWalkStacks(). */
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		tskPERIODIC *pxPeriodic;				/*< NULL unless xTaskSetPeriodic() was called. */
+	#endif
+
 } tskTCB;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticTask in task.h must mirror the TCB above, or the storage the
+	application supplies to xTaskCreateStatic() would be the wrong size. */
+	typedef char xStaticTaskSizeCheck[ ( sizeof( xStaticTask ) == sizeof( tskTCB ) ) ? 1 : -1 ];
+
+	/* Values of ucStaticallyAllocated. */
+	#define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB		( ( unsigned char ) 0U )
+	#define tskSTATICALLY_ALLOCATED_STACK_ONLY			( ( unsigned char ) 1U )
+	#define tskSTATICALLY_ALLOCATED_STACK_AND_TCB		( ( unsigned char ) 2U )
+
+#endif
+
 
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
@@ -146,10 +231,32 @@ PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
 /* Lists for ready and blocked tasks. --------------------*/
 
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* Delayed tasks are kept in a two level timer wheel rather than in lists
+	sorted by wake time.  A task due within tskWHEEL_SLOTS ticks goes in the
+	level 0 slot picked by the low bits of its wake time, one due within
+	tskWHEEL_SPAN ticks in the level 1 slot picked by the next bits, and
+	anything further out in xDelayedTaskFarList.  Slots are unsorted so
+	blocking is O(1).  Each tick wakes everything in one level 0 slot, and
+	every tskWHEEL_SLOTS ticks a level 1 slot is redistributed (cascaded) over
+	level 0, every tskWHEEL_SPAN ticks the far list over both levels. */
+	#define tskWHEEL_BITS		( 5 )
+	#define tskWHEEL_SLOTS		( 1 << tskWHEEL_BITS )
+	#define tskWHEEL_MASK		( ( portTickType ) ( tskWHEEL_SLOTS - 1 ) )
+	#define tskWHEEL_SPAN		( ( portTickType ) tskWHEEL_SLOTS * tskWHEEL_SLOTS )
+
+	PRIVILEGED_DATA static xList xDelayedTaskWheel[ 2 ][ tskWHEEL_SLOTS ];	/*< Delayed tasks, level 0 and level 1 slots. */
+	PRIVILEGED_DATA static xList xDelayedTaskFarList;						/*< Delayed tasks due tskWHEEL_SPAN or more ticks from when they blocked. */
+
+#else
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready queue when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -217,13 +324,127 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  * executing task, then it will only be rescheduled after the currently
  * executing task has been rescheduled.
  */
-#define prvAddTaskToReadyQueue( pxTCB )																					\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB )																				\
-	if( ( pxTCB )->uxPriority > uxTopReadyPriority )																	\
+#if ( configUSE_EDF_SCHEDULING == 0 )
+
+	#define prvAddTaskToReadyQueue( pxTCB )																				\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																			\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																\
+		vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority )	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#else
+
+	/*
+	 * The ready list of configEDF_PRIORITY is instead kept sorted by absolute
+	 * deadline and its head, the earliest deadline, is always the one selected.
+	 * A task at that priority that is not periodic, such as one that inherited
+	 * it through a mutex an EDF task waits for, has a deadline of 0 and so runs
+	 * first.  Deadlines are compared as plain tick counts, so for the few
+	 * periods around a tick count overflow the order can be wrong.
+	 */
+	#define prvAbsoluteDeadline( pxTCB )																				\
+		( ( ( pxTCB )->pxPeriodic != NULL ) ? ( pxTCB )->pxPeriodic->xAbsoluteDeadline : ( portTickType ) 0U )
+
+	#define prvAddTaskToReadyQueue( pxTCB )																				\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																			\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																\
+		if( ( pxTCB )->uxPriority == configEDF_PRIORITY )																\
+		{																												\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xGenericListItem ), prvAbsoluteDeadline( pxTCB ) );					\
+			vListInsert( ( xList * ) &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}																												\
+		else																											\
+		{																												\
+			vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority )																	\
 	{																													\
-		uxTopReadyPriority = ( pxTCB )->uxPriority;																		\
-	}																													\
-	vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+		if( ( uxPriority ) == configEDF_PRIORITY )																		\
+		{																												\
+			pxCurrentTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );	\
+		}																												\
+		else																											\
+		{																												\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );						\
+		}																												\
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+	/*
+	 * uxTopReadyPriority holds the highest priority that may have a ready
+	 * task.  Selecting a task walks down from there to the first ready list
+	 * that is not empty, so the cost grows with the gap between priorities in
+	 * use.
+	 */
+	#define taskRECORD_READY_PRIORITY( uxPriority )										\
+	{																					\
+		if( ( uxPriority ) > uxTopReadyPriority )										\
+		{																				\
+			uxTopReadyPriority = ( uxPriority );										\
+		}																				\
+	}
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()											\
+	{																					\
+		/* Find the highest priority queue that contains ready tasks. */				\
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )	\
+		{																				\
+			configASSERT( uxTopReadyPriority );											\
+			--uxTopReadyPriority;														\
+		}																				\
+																						\
+		/* Outside the EDF list this walks through the list, so the tasks of the	\
+		same priority get an equal share of the processor time. */					\
+		taskSELECT_FROM_READY_LIST( uxTopReadyPriority );							\
+	}
+
+	/* The watermark is lowered lazily by taskSELECT_HIGHEST_PRIORITY_TASK(). */
+	#define taskRESET_READY_PRIORITY( uxPriority )
+
+#else
+
+	/*
+	 * uxTopReadyPriority is a bitmap with one bit per priority that has ready
+	 * tasks, and the port finds the highest set bit in a single instruction,
+	 * so selecting a task costs the same whatever configMAX_PRIORITIES is.
+	 */
+	#if !defined( portRECORD_READY_PRIORITY ) || !defined( portRESET_READY_PRIORITY ) || !defined( portGET_HIGHEST_PRIORITY )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION is not supported by this port
+	#endif
+
+	/* Fails to compile if there are more priorities than bits in the map
+	(configMAX_PRIORITIES is a cast expression, the preprocessor cannot check
+	it). */
+	typedef char xReadyPriorityBitmapCheck[ ( configMAX_PRIORITIES <= ( sizeof( unsigned portBASE_TYPE ) * 8 ) ) ? 1 : -1 ];
+
+	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()											\
+	{																					\
+	unsigned portBASE_TYPE uxTopPriority;												\
+																						\
+		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );					\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );	\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );									\
+	}
+
+	/* Must follow every removal from a ready list, with the priority of the
+	list the task was removed from. */
+	#define taskRESET_READY_PRIORITY( uxPriority )										\
+	{																					\
+		if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) )			\
+		{																				\
+			portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority );				\
+		}																				\
+	}
+
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -234,6 +455,12 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  * once one tasks has been found whose timer has not expired we need not look
  * any further down the list.
  */
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	#define prvCheckDelayedTasks()	prvWheelAdvance()
+
+#else
+
 #define prvCheckDelayedTasks()															\
 {																						\
 portTickType xItemValue;																\
@@ -285,6 +512,8 @@ portTickType xItemValue;																\
 		}																				\
 	}																					\
 }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
 /*
@@ -346,17 +575,64 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used only by the idle task when configUSE_TICKLESS_IDLE is 1.  Returns the
+ * number of ticks that can pass before a task has to be unblocked, or 0 if
+ * another task is ready to run and the idle task must not sleep.
+ */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
  */
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used by the notification functions.  prvBlockForNotification() moves the
+ * calling task off the ready list for xTicksToWait ticks, and must be called
+ * from a critical section.  prvApplyNotification() updates the notification
+ * value of pxTCB as eAction says, given the state the task was in before.
+ */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockForNotification( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	static portBASE_TYPE prvApplyNotification( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction, eNotifyValue eOriginalNotifyState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Timer wheel helpers, used when configUSE_DELAYED_TASK_WHEEL is 1.
+ * prvWheelInsert() files a delayed task's generic list item, whose value is
+ * its wake time, in the slot matching how far away that time is.
+ * prvWheelAdvance() is called for every tick to cascade and wake the slots
+ * that are due.  xNextTaskUnblockTime is kept as the next tick at which the
+ * wheel has something to do, as tickless idle must not skip that tick.
+ */
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static void prvWheelInsert( xListItem *pxListItem ) PRIVILEGED_FUNCTION;
+	static void prvWheelCascade( xList *pxList ) PRIVILEGED_FUNCTION;
+	static void prvWheelAdvance( void ) PRIVILEGED_FUNCTION;
+	static void prvWheelUpdateNextUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * allocation was successful.  Either comes from the application instead when
+ * puxStackBuffer or pxTaskBuffer is not NULL.
+ */
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The body of xTaskGenericCreate() and xTaskCreateStatic().
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
 
 /*
  * Called from vTaskList.  vListTasks details all the tasks currently under
@@ -373,12 +649,32 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
+/*
+ * Called from vTaskWalkStacks for each list that could contain a TCB, calls
+ * pxCallback for every task within just that list.
+ */
+#if ( INCLUDE_vTaskWalkStacks == 1 )
+
+	static void prvWalkStacksWithinSingleList( xList *pxList, tskSTACK_CALLBACK pxCallback, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from vTaskListPeriodic for each list that could contain a TCB, adds
+ * a line for every periodic task within just that list.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvListPeriodicWithinSingleList( const signed char *pcWriteBuffer, xList *pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_vTaskWalkStacks == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte ) PRIVILEGED_FUNCTION;
 
@@ -394,6 +690,34 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  *----------------------------------------------------------*/
 
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+{
+	return prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, xRegions, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE * const puxStackBuffer, xStaticTask * const pxTaskBuffer )
+	{
+	xTaskHandle xReturn = NULL;
+
+		configASSERT( puxStackBuffer != NULL );
+		configASSERT( pxTaskBuffer != NULL );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			/* Nothing is allocated, so this can only fail on bad
+			parameters, which the asserts above catch. */
+			( void ) prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xReturn, puxStackBuffer, NULL, pxTaskBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask *pxTaskBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
@@ -403,7 +727,7 @@ tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTaskBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -452,6 +776,12 @@ tskTCB * pxNewTCB;
 		/* Setup the newly allocated TCB with the initial state of the task. */
 		prvInitialiseTCBVariables( pxNewTCB, pcName, uxPriority, xRegions, usStackDepth );
 
+		#if ( INCLUDE_vTaskWalkStacks == 1 )
+		{
+			pxNewTCB->usStackDepth = usStackDepth;
+		}
+		#endif
+
 		/* Initialize the TCB stack to look as if the task was already running,
 		but had been interrupted by the scheduler.  The return address is set
 		to the start of the task function. Once the stack has been initialised
@@ -579,6 +909,7 @@ tskTCB * pxNewTCB;
 			the termination list and free up any memory allocated by the
 			scheduler for the TCB and stack. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer != NULL )
@@ -671,6 +1002,7 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 		}
@@ -687,6 +1019,125 @@ tskTCB * pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	portBASE_TYPE xTaskSetPeriodic( xTaskHandle pxTask, portTickType xPeriod, portTickType xRelativeDeadline )
+	{
+	tskTCB *pxTCB;
+	tskPERIODIC *pxPeriodic, *pxSpare = NULL;
+
+		configASSERT( xPeriod > 0U );
+		configASSERT( ( xRelativeDeadline > 0U ) && ( xRelativeDeadline <= xPeriod ) );
+
+		pxTCB = prvGetTCBFromHandle( pxTask );
+
+		/* The state is allocated outside the critical section, and given back
+		if another call got there first. */
+		if( pxTCB->pxPeriodic == NULL )
+		{
+			pxSpare = ( tskPERIODIC * ) pvPortMalloc( sizeof( tskPERIODIC ) );
+			if( pxSpare == NULL )
+			{
+				return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+			}
+		}
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->pxPeriodic == NULL )
+			{
+				pxTCB->pxPeriodic = pxSpare;
+				pxSpare = NULL;
+			}
+			pxPeriodic = pxTCB->pxPeriodic;
+
+			/* The first job is released now. */
+			pxPeriodic->xPeriod = xPeriod;
+			pxPeriodic->xRelativeDeadline = xRelativeDeadline;
+			pxPeriodic->xRelease = xTickCount;
+			pxPeriodic->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+			pxPeriodic->ulJobs = 0UL;
+			pxPeriodic->ulDeadlineMisses = 0UL;
+			pxPeriodic->xWorstResponse = ( portTickType ) 0U;
+
+			/* A ready task in the EDF class moves to its place under the new
+			deadline, which may put another task ahead of it. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+			{
+				vListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+				portYIELD_WITHIN_API();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxSpare != NULL )
+		{
+			vPortFree( pxSpare );
+		}
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskWaitForNextPeriod( void )
+	{
+	portTickType xTimeNow, xResponse, xTicksToRelease;
+	portBASE_TYPE xAlreadyYielded;
+	tskPERIODIC *pxPeriodic = pxCurrentTCB->pxPeriodic;
+
+		configASSERT( pxPeriodic );
+
+		vTaskSuspendAll();
+		{
+			xTimeNow = xTickCount;
+
+			/* Account for the job that has just completed. */
+			xResponse = xTimeNow - pxPeriodic->xRelease;
+			pxPeriodic->ulJobs++;
+			if( xResponse > pxPeriodic->xWorstResponse )
+			{
+				pxPeriodic->xWorstResponse = xResponse;
+			}
+			if( xResponse > pxPeriodic->xRelativeDeadline )
+			{
+				pxPeriodic->ulDeadlineMisses++;
+				traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+			}
+
+			/* The next job is released one period after the last, however
+			late that one finished, so releases do not drift. */
+			pxPeriodic->xRelease += pxPeriodic->xPeriod;
+			pxPeriodic->xAbsoluteDeadline = pxPeriodic->xRelease + pxPeriodic->xRelativeDeadline;
+
+			/* We must remove ourselves from the ready list before adding
+			ourselves to the blocked list as the same list item is used for
+			both lists. */
+			vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+			xTicksToRelease = pxPeriodic->xRelease - xTimeNow;
+			if( ( xTicksToRelease != ( portTickType ) 0U ) && ( xTicksToRelease <= pxPeriodic->xPeriod ) )
+			{
+				prvAddCurrentTaskToDelayedList( pxPeriodic->xRelease );
+			}
+			else
+			{
+				/* The job overran into its next period, which is released
+				already.  Back to the ready list under the new deadline. */
+				prvAddTaskToReadyQueue( pxCurrentTCB );
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( portTickType xTicksToDelay )
@@ -717,6 +1168,7 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 			xAlreadyYielded = xTaskResumeAll();
@@ -836,7 +1288,12 @@ tskTCB * pxNewTCB;
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				/* Only reset the event list item value if it is not being
+				used for something else, see vTaskPlaceOnUnorderedEventList(). */
+				if( taskEVENT_LIST_ITEM_VALUE_IS_FREE( pxTCB ) )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				}
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change it's priority variable. However, if
@@ -848,6 +1305,7 @@ tskTCB * pxNewTCB;
 					it to it's new ready list.  As we are in a critical section we
 					can do this even if the scheduler is suspended. */
 					vListRemove( &( pxTCB->xGenericListItem ) );
+					taskRESET_READY_PRIORITY( uxCurrentPriority );
 					prvAddTaskToReadyQueue( pxTCB );
 				}
 
@@ -885,6 +1343,7 @@ tskTCB * pxNewTCB;
 
 			/* Remove task from the ready/delayed list and place in the	suspended list. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer != NULL )
@@ -1081,6 +1540,15 @@ portBASE_TYPE xReturn;
 	}
 	#endif
 
+	#if ( configUSE_DEFERRED_CALLS == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xDeferredCreateDaemonTask();
+		}
+	}
+	#endif
+
 	if( xReturn == pdPASS )
 	{
 		/* Interrupts are turned off here, to ensure a tick does not occur
@@ -1135,6 +1603,7 @@ void vTaskSuspendAll( void )
 	/* A critical section is not required as the variable is of type
 	portBASE_TYPE. */
 	++uxSchedulerSuspended;
+	traceSUSPEND_ALL( uxSchedulerSuspended );
 }
 /*----------------------------------------------------------*/
 
@@ -1155,6 +1624,7 @@ signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 	taskENTER_CRITICAL();
 	{
 		--uxSchedulerSuspended;
+		traceRESUME_ALL( uxSchedulerSuspended );
 
 		if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 		{
@@ -1305,15 +1775,37 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
-			}
+			xList *pxList;
+
+				for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) ( 2 * tskWHEEL_SLOTS ); uxQueue++ )
+				{
+					pxList = &( xDelayedTaskWheel[ uxQueue >> tskWHEEL_BITS ][ uxQueue & tskWHEEL_MASK ] );
+					if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+					{
+						prvListTaskWithinSingleList( pcWriteBuffer, pxList, tskBLOCKED_CHAR );
+					}
+				}
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				if( listLIST_IS_EMPTY( &xDelayedTaskFarList ) == pdFALSE )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, &xDelayedTaskFarList, tskBLOCKED_CHAR );
+				}
+			}
+			#else
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
+				}
+
+				if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+				}
 			}
+			#endif
 
 			#if( INCLUDE_vTaskDelete == 1 )
 			{
@@ -1339,35 +1831,15 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 #endif
 /*----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( INCLUDE_vTaskWalkStacks == 1 )
 
-	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	void vTaskWalkStacks( tskSTACK_CALLBACK pxCallback, void *pvParameter )
 	{
 	unsigned portBASE_TYPE uxQueue;
-	unsigned long ulTotalRunTime;
-
-		/* This is a VERY costly function that should be used for debug only.
-		It leaves interrupts disabled for a LONG time. */
 
+		/* The same lists as vTaskList(), and as costly. */
 		vTaskSuspendAll();
 		{
-			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-			#else
-				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-			#endif
-
-			/* Divide ulTotalRunTime by 100 to make the percentage caluclations
-			simpler in the prvGenerateRunTimeStatsForTasksInList() function. */
-			ulTotalRunTime /= 100UL;
-			
-			/* Run through all the lists that could potentially contain a TCB,
-			generating a table of run timer percentages in the provided
-			buffer. */
-
-			*pcWriteBuffer = ( signed char ) 0x00;
-			strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
-
 			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
 
 			do
@@ -1376,25 +1848,47 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
 				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), ulTotalRunTime );
+					prvWalkStacksWithinSingleList( ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), pxCallback, pvParameter );
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
-			}
+			xList *pxList;
+
+				for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) ( 2 * tskWHEEL_SLOTS ); uxQueue++ )
+				{
+					pxList = &( xDelayedTaskWheel[ uxQueue >> tskWHEEL_BITS ][ uxQueue & tskWHEEL_MASK ] );
+					if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+					{
+						prvWalkStacksWithinSingleList( pxList, pxCallback, pvParameter );
+					}
+				}
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				if( listLIST_IS_EMPTY( &xDelayedTaskFarList ) == pdFALSE )
+				{
+					prvWalkStacksWithinSingleList( &xDelayedTaskFarList, pxCallback, pvParameter );
+				}
+			}
+			#else
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvWalkStacksWithinSingleList( ( xList * ) pxDelayedTaskList, pxCallback, pvParameter );
+				}
+
+				if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				{
+					prvWalkStacksWithinSingleList( ( xList * ) pxOverflowDelayedTaskList, pxCallback, pvParameter );
+				}
 			}
+			#endif
 
-			#if ( INCLUDE_vTaskDelete == 1 )
+			#if( INCLUDE_vTaskDelete == 1 )
 			{
 				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
 				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &xTasksWaitingTermination, ulTotalRunTime );
+					prvWalkStacksWithinSingleList( &xTasksWaitingTermination, pxCallback, pvParameter );
 				}
 			}
 			#endif
@@ -1403,7 +1897,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 			{
 				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
 				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &xSuspendedTaskList, ulTotalRunTime );
+					prvWalkStacksWithinSingleList( &xSuspendedTaskList, pxCallback, pvParameter );
 				}
 			}
 			#endif
@@ -1411,10 +1905,178 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 		xTaskResumeAll();
 	}
 
-#endif
+#endif /* INCLUDE_vTaskWalkStacks */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskListPeriodic( signed char *pcWriteBuffer )
+	{
+	unsigned portBASE_TYPE uxQueue;
+
+		/* The same lists as vTaskList(), and as costly.  Tasks waiting to be
+		deleted are left out. */
+		vTaskSuspendAll();
+		{
+			*pcWriteBuffer = ( signed char ) 0x00;
+
+			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+
+			do
+			{
+				uxQueue--;
+
+				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				{
+					prvListPeriodicWithinSingleList( pcWriteBuffer, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ) );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+			xList *pxList;
+
+				for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) ( 2 * tskWHEEL_SLOTS ); uxQueue++ )
+				{
+					pxList = &( xDelayedTaskWheel[ uxQueue >> tskWHEEL_BITS ][ uxQueue & tskWHEEL_MASK ] );
+					if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+					{
+						prvListPeriodicWithinSingleList( pcWriteBuffer, pxList );
+					}
+				}
+
+				if( listLIST_IS_EMPTY( &xDelayedTaskFarList ) == pdFALSE )
+				{
+					prvListPeriodicWithinSingleList( pcWriteBuffer, &xDelayedTaskFarList );
+				}
+			}
+			#else
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvListPeriodicWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList );
+				}
+
+				if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				{
+					prvListPeriodicWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				{
+					prvListPeriodicWithinSingleList( pcWriteBuffer, &xSuspendedTaskList );
+				}
+			}
+			#endif
+		}
+		xTaskResumeAll();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	{
+	unsigned portBASE_TYPE uxQueue;
+	unsigned long ulTotalRunTime;
+
+		/* This is a VERY costly function that should be used for debug only.
+		It leaves interrupts disabled for a LONG time. */
+
+		vTaskSuspendAll();
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+			#else
+				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+
+			/* Divide ulTotalRunTime by 100 to make the percentage caluclations
+			simpler in the prvGenerateRunTimeStatsForTasksInList() function. */
+			ulTotalRunTime /= 100UL;
+			
+			/* Run through all the lists that could potentially contain a TCB,
+			generating a table of run timer percentages in the provided
+			buffer. */
+
+			*pcWriteBuffer = ( signed char ) 0x00;
+			strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
+
+			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+
+			do
+			{
+				uxQueue--;
+
+				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), ulTotalRunTime );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+			xList *pxList;
+
+				for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) ( 2 * tskWHEEL_SLOTS ); uxQueue++ )
+				{
+					pxList = &( xDelayedTaskWheel[ uxQueue >> tskWHEEL_BITS ][ uxQueue & tskWHEEL_MASK ] );
+					if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+					{
+						prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, pxList, ulTotalRunTime );
+					}
+				}
+
+				if( listLIST_IS_EMPTY( &xDelayedTaskFarList ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &xDelayedTaskFarList, ulTotalRunTime );
+				}
+			}
+			#else
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
+				}
+
+				if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskDelete == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &xTasksWaitingTermination, ulTotalRunTime );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &xSuspendedTaskList, ulTotalRunTime );
+				}
+			}
+			#endif
+		}
+		xTaskResumeAll();
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	xTaskHandle xTaskGetIdleTaskHandle( void )
 	{
@@ -1433,7 +2095,9 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 void vTaskIncrementTick( void )
 {
-tskTCB * pxTCB;
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+	tskTCB * pxTCB;
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
@@ -1441,6 +2105,17 @@ tskTCB * pxTCB;
 	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 	{
 		++xTickCount;
+		#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* The wheel slots are picked by the low bits of the wake time,
+			which carry on across the overflow, so there is nothing to swap.
+			prvWheelAdvance() recalculates xNextTaskUnblockTime. */
+			if( xTickCount == ( portTickType ) 0U )
+			{
+				xNumOfOverflows++;
+			}
+		}
+		#else
 		if( xTickCount == ( portTickType ) 0U )
 		{
 			xList *pxTemp;
@@ -1474,6 +2149,7 @@ tskTCB * pxTCB;
 				xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
 			}
 		}
+		#endif
 
 		/* See if this tick has made a timeout expire. */
 		prvCheckDelayedTasks();
@@ -1506,6 +2182,43 @@ tskTCB * pxTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	void vTaskStepTick( portTickType xTicksToJump )
+	{
+		/* Called by the port with the scheduler suspended, after it has slept
+		through xTicksToJump tick periods without taking a tick interrupt.  The
+		port never sleeps past xNextTaskUnblockTime so no task can have timed
+		out in the meantime and the delayed lists need not be checked. */
+		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		xTickCount += xTicksToJump;
+		traceINCREASE_TICK_COUNT( xTicksToJump );
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskConfirmSleepModeStatus( void )
+	{
+	portBASE_TYPE xReturn = pdTRUE;
+
+		/* Called by the port with interrupts disabled, just before it sleeps.
+		An interrupt that arrived after the idle task decided to sleep may
+		have readied a task (it waits in xPendingReadyList as the scheduler is
+		suspended) or asked for a context switch. */
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != ( unsigned portBASE_TYPE ) 0U )
+		{
+			xReturn = pdFALSE;
+		}
+		else if( xMissedYield != pdFALSE )
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_APPLICATION_TASK_TAG == 1 )
 
 	void vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction )
@@ -1628,16 +2341,7 @@ void vTaskSwitchContext( void )
 		taskFIRST_CHECK_FOR_STACK_OVERFLOW();
 		taskSECOND_CHECK_FOR_STACK_OVERFLOW();
 	
-		/* Find the highest priority queue that contains ready tasks. */
-		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
-		{
-			configASSERT( uxTopReadyPriority );
-			--uxTopReadyPriority;
-		}
-	
-		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the
-		same priority get an equal share of the processor time. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );
+		taskSELECT_HIGHEST_PRIORITY_TASK();
 	
 		traceTASK_SWITCHED_IN();
 	}
@@ -1662,6 +2366,7 @@ portTickType xTimeToWake;
 	to the blocked list as the same list item is used for both lists.  We have
 	exclusive access to the ready lists as the scheduler is locked. */
 	vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
 
 	#if ( INCLUDE_vTaskSuspend == 1 )
@@ -1692,6 +2397,65 @@ portTickType xTimeToWake;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
+	{
+	portTickType xTimeToWake;
+
+		configASSERT( pxEventList );
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is
+		used by the event groups implementation. */
+		configASSERT( uxSchedulerSuspended != 0 );
+
+		/* Store the item value in the event list item.  It is safe to access
+		the event list item here as interrupts won't access the event list item
+		of a task that is not in the Blocked state. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		/* Place the event list item of the TCB at the end of the appropriate
+		event list.  It is safe to access the event list here because it is
+		part of an event group implementation - and interrupts don't access
+		event groups directly (instead they access them indirectly by pending
+		function calls to the task level). */
+		vListInsertEnd( pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+
+		/* The task must be removed from the ready list before it is added to
+		the blocked list.  Exclusive access can be assured to the ready list
+		as the scheduler is locked. */
+		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Add the task to the suspended task list instead of a delayed
+				task list to ensure it is not woken by a timing event.  It will
+				block indefinitely. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				/* Calculate the time at which the task should be woken if the
+				event does not occur.  This may overflow but this doesn't
+				matter. */
+				xTimeToWake = xTickCount + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
+		}
+		#else
+		{
+				xTimeToWake = xTickCount + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+		#endif
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
 #if configUSE_TIMERS == 1
 
 	void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickType xTicksToWait )
@@ -1716,6 +2480,7 @@ portTickType xTimeToWake;
 		blocked list as the same list item is used for both lists.  This
 		function is called form a critical section. */
 		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
 		/* Calculate the time at which the task should be woken if the event does
 		not occur.  This may overflow but this doesn't matter. */
@@ -1777,6 +2542,73 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+	{
+	tskTCB *pxUnblockedTCB;
+	portBASE_TYPE xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is
+		used by the event flags implementation. */
+		configASSERT( uxSchedulerSuspended != pdFALSE );
+
+		/* Store the new item value in the event list, the waiting task reads
+		it back with uxTaskResetEventItemValue(). */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		/* Remove the TCB from the event list. */
+		pxUnblockedTCB = ( tskTCB * ) pxEventListItem->pvOwner;
+		configASSERT( pxUnblockedTCB );
+		vListRemove( pxEventListItem );
+
+		/* The scheduler is suspended so the delayed and ready lists cannot be
+		touched, hold the task pending until the scheduler is resumed.  The
+		pending ready list is shared with interrupts, hence the critical
+		section. */
+		taskENTER_CRITICAL();
+		{
+			vListInsertEnd( ( xList * ) &( xPendingReadyList ), pxEventListItem );
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxUnblockedTCB->uxPriority >= pxCurrentTCB->uxPriority )
+		{
+			/* Return true if the task removed from the event list has
+			a higher priority than the calling task.  This allows
+			the calling task to know if it should force a context
+			switch now. */
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	portTickType uxTaskResetEventItemValue( void )
+	{
+	portTickType uxReturn;
+
+		uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+		/* Reset the event list item to its normal value - so it can be used
+		with queues and semaphores. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) );
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -1933,22 +2765,79 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			vApplicationIdleHook();
 		}
 		#endif
+
+		#if ( configUSE_TICKLESS_IDLE == 1 )
+		{
+		portTickType xExpectedIdleTime;
+
+			/* Only sleep if nothing needs the processor for a few ticks, the
+			test is repeated with the scheduler suspended as the first one is
+			made without it and may already be stale. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					configASSERT( xNextTaskUnblockTime >= xTickCount );
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						traceLOW_POWER_IDLE_BEGIN();
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+						traceLOW_POWER_IDLE_END();
+					}
+				}
+				xTaskResumeAll();
+			}
+		}
+		#endif
 	}
 } /*lint !e715 pvParameters is not accessed but all task functions require the same prototype. */
+/*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
 
+	static portTickType prvGetExpectedIdleTime( void )
+	{
+	portTickType xReturn;
 
+		if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+		{
+			xReturn = 0;
+		}
+		else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( unsigned portBASE_TYPE ) 1 )
+		{
+			/* Another task shares the idle priority and is ready. */
+			xReturn = 0;
+		}
+		else
+		{
+			/* xNextTaskUnblockTime may be earlier than the real next wake
+			time if a task left the delayed list early, which only makes the
+			sleep shorter than it could be. */
+			xReturn = xNextTaskUnblockTime - xTickCount;
+		}
 
+		return xReturn;
+	}
 
+#endif /* configUSE_TICKLESS_IDLE */
 
 
-/*-----------------------------------------------------------
- * File private functions documented at the top of the file.
- *----------------------------------------------------------*/
 
 
 
-static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
+
+
+/*-----------------------------------------------------------
+ * File private functions documented at the top of the file.
+ *----------------------------------------------------------*/
+
+
+
+static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
 {
 	/* Store the function name in the TCB. */
 	#if configMAX_TASK_NAME_LEN > 1
@@ -2002,6 +2891,19 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 	}
 	#endif
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->eNotifyState = eNotWaitingNotification;
+	}
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxTCB->pxPeriodic = NULL;
+	}
+	#endif
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
@@ -2043,8 +2945,22 @@ unsigned portBASE_TYPE uxPriority;
 		vListInitialise( ( xList * ) &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( ( xList * ) &xDelayedTaskList1 );
-	vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < ( unsigned portBASE_TYPE ) tskWHEEL_SLOTS; uxPriority++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ 0 ][ uxPriority ] ) );
+			vListInitialise( &( xDelayedTaskWheel[ 1 ][ uxPriority ] ) );
+		}
+		vListInitialise( &xDelayedTaskFarList );
+	}
+	#else
+	{
+		vListInitialise( ( xList * ) &xDelayedTaskList1 );
+		vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	}
+	#endif
+
 	vListInitialise( ( xList * ) &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -2059,10 +2975,14 @@ unsigned portBASE_TYPE uxPriority;
 	}
 	#endif
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2103,9 +3023,15 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 {
-	/* The list item will be inserted in wake time order. */
+	/* The list item will be inserted in wake time order, or filed in the
+	timer wheel by its wake time. */
 	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
 
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		prvWheelInsert( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	}
+	#else
 	if( xTimeToWake < xTickCount )
 	{
 		/* Wake time has overflowed.  Place this item in the overflow list. */
@@ -2124,16 +3050,187 @@ static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 			xNextTaskUnblockTime = xTimeToWake;
 		}
 	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* Records xTime as the next tick the wheel has work at if it comes
+	before the one already recorded.  Times past the tick count overflow are
+	not recorded, xNextTaskUnblockTime is recalculated at the overflow. */
+	#define prvWheelNoteEventTime( xTime )											\
+	{																				\
+		if( ( ( xTime ) > xTickCount ) && ( ( xTime ) < xNextTaskUnblockTime ) )	\
+		{																			\
+			xNextTaskUnblockTime = ( xTime );										\
+		}																			\
+	}
+
+	static void prvWheelInsert( xListItem *pxListItem )
+	{
+	portTickType xTimeToWake, xTicksToWait, xEventTime;
+	xList *pxList;
+
+		/* The distance is taken modulo the tick width so wake times past the
+		tick count overflow need no special treatment. */
+		xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+		xTicksToWait = xTimeToWake - xTickCount;
+
+		if( xTicksToWait < ( portTickType ) tskWHEEL_SLOTS )
+		{
+			/* Woken when the tick count reaches the wake time. */
+			pxList = &( xDelayedTaskWheel[ 0 ][ xTimeToWake & tskWHEEL_MASK ] );
+			xEventTime = xTimeToWake;
+		}
+		else if( xTicksToWait < tskWHEEL_SPAN )
+		{
+			/* Cascaded to level 0 at the start of the tskWHEEL_SLOTS tick
+			block holding the wake time. */
+			pxList = &( xDelayedTaskWheel[ 1 ][ ( xTimeToWake >> tskWHEEL_BITS ) & tskWHEEL_MASK ] );
+			xEventTime = xTimeToWake & ~tskWHEEL_MASK;
+		}
+		else
+		{
+			/* Cascaded again at the next multiple of tskWHEEL_SPAN. */
+			pxList = &xDelayedTaskFarList;
+			xEventTime = ( xTickCount | ( tskWHEEL_SPAN - 1 ) ) + 1;
+		}
+
+		vListInsertEnd( pxList, pxListItem );
+		prvWheelNoteEventTime( xEventTime );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWheelCascade( xList *pxList )
+	{
+	xList xCascadeList;
+	xListItem *pxListItem;
+
+		/* Detach the items first.  Far list items may go straight back on the
+		far list, where they must not be seen again by this loop. */
+		vListInitialise( &xCascadeList );
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxListItem = ( xListItem * ) pxList->xListEnd.pxNext;
+			vListRemove( pxListItem );
+			vListInsertEnd( &xCascadeList, pxListItem );
+		}
+
+		while( listLIST_IS_EMPTY( &xCascadeList ) == pdFALSE )
+		{
+			pxListItem = ( xListItem * ) xCascadeList.xListEnd.pxNext;
+			vListRemove( pxListItem );
+			prvWheelInsert( pxListItem );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWheelAdvance( void )
+	{
+	xList *pxList;
+	tskTCB *pxTCB;
+
+		/* Cascade the higher levels first, they may have tasks due on this
+		very tick. */
+		if( ( xTickCount & ( tskWHEEL_SPAN - 1 ) ) == ( portTickType ) 0U )
+		{
+			prvWheelCascade( &xDelayedTaskFarList );
+		}
+
+		if( ( xTickCount & tskWHEEL_MASK ) == ( portTickType ) 0U )
+		{
+			prvWheelCascade( &( xDelayedTaskWheel[ 1 ][ ( xTickCount >> tskWHEEL_BITS ) & tskWHEEL_MASK ] ) );
+		}
+
+		/* Everything in the level 0 slot for this tick is due now. */
+		pxList = &( xDelayedTaskWheel[ 0 ][ xTickCount & tskWHEEL_MASK ] );
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxList );
+			configASSERT( listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ) == xTickCount );
+			vListRemove( &( pxTCB->xGenericListItem ) );
+
+			/* Is the task waiting on an event also? */
+			if( pxTCB->xEventListItem.pvContainer != NULL )
+			{
+				vListRemove( &( pxTCB->xEventListItem ) );
+			}
+			prvAddTaskToReadyQueue( pxTCB );
+		}
+
+		if( ( xTickCount == ( portTickType ) 0U ) || ( xTickCount >= xNextTaskUnblockTime ) )
+		{
+			prvWheelUpdateNextUnblockTime();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWheelUpdateNextUnblockTime( void )
+	{
+	portTickType xTime;
+	unsigned portBASE_TYPE uxSlot;
+
+		/* Only called when the recorded time has been reached, so the scan
+		over the slots is not made on every tick.  Tasks that left the wheel
+		early can make the result earlier than needed, never later. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+
+		for( uxSlot = ( unsigned portBASE_TYPE ) 1U; uxSlot < ( unsigned portBASE_TYPE ) tskWHEEL_SLOTS; uxSlot++ )
+		{
+			xTime = xTickCount + ( portTickType ) uxSlot;
+			if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ 0 ][ xTime & tskWHEEL_MASK ] ) ) == pdFALSE )
+			{
+				prvWheelNoteEventTime( xTime );
+				break;
+			}
+		}
+
+		for( uxSlot = ( unsigned portBASE_TYPE ) 1U; uxSlot <= ( unsigned portBASE_TYPE ) tskWHEEL_SLOTS; uxSlot++ )
+		{
+			xTime = ( xTickCount & ~tskWHEEL_MASK ) + ( ( portTickType ) uxSlot << tskWHEEL_BITS );
+			if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ 1 ][ ( xTime >> tskWHEEL_BITS ) & tskWHEEL_MASK ] ) ) == pdFALSE )
+			{
+				prvWheelNoteEventTime( xTime );
+				break;
+			}
+		}
+
+		if( listLIST_IS_EMPTY( &xDelayedTaskFarList ) == pdFALSE )
+		{
+			xTime = ( xTickCount | ( tskWHEEL_SPAN - 1 ) ) + 1;
+			prvWheelNoteEventTime( xTime );
+		}
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
 {
 tskTCB *pxNewTCB;
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		if( pxTaskBuffer != NULL )
+		{
+			/* The application supplied the TCB, its size was checked against
+			xStaticTask when this file was compiled. */
+			pxNewTCB = ( tskTCB * ) pxTaskBuffer;
+		}
+		else
+		{
+			pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+		}
+	}
+	#else
+	{
+		/* Allocate space for the TCB.  Where the memory comes from depends on
+		the implementation of the port malloc function. */
+		( void ) pxTaskBuffer;
+		pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	}
+	#endif
 
 	if( pxNewTCB != NULL )
 	{
@@ -2144,7 +3241,9 @@ tskTCB *pxNewTCB;
 
 		if( pxNewTCB->pxStack == NULL )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
+			/* Could not allocate the stack.  Delete the allocated TCB, the
+			stack can only fail when it comes from the heap, and then so did
+			the TCB. */
 			vPortFree( pxNewTCB );
 			pxNewTCB = NULL;
 		}
@@ -2152,6 +3251,24 @@ tskTCB *pxNewTCB;
 		{
 			/* Just to help debugging. */
 			memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Remember what must not be freed if the task is deleted. */
+				if( pxTaskBuffer != NULL )
+				{
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+				else if( puxStackBuffer != NULL )
+				{
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+				}
+				else
+				{
+					pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+			}
+			#endif
 		}
 	}
 
@@ -2191,6 +3308,61 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskWalkStacks == 1 )
+
+	static void prvWalkStacksWithinSingleList( xList *pxList, tskSTACK_CALLBACK pxCallback, void *pvParameter )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned short usStackRemaining;
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
+			}
+			#else
+			{
+				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
+			}
+			#endif
+
+			pxCallback( ( xTaskHandle ) pxNextTCB, ( const signed char * ) pxNextTCB->pcTaskName, pxNextTCB->usStackDepth, usStackRemaining, pvParameter );
+
+		} while( pxNextTCB != pxFirstTCB );
+	}
+
+#endif /* INCLUDE_vTaskWalkStacks */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvListPeriodicWithinSingleList( const signed char *pcWriteBuffer, xList *pxList )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	tskPERIODIC *pxPeriodic;
+	PRIVILEGED_DATA static char pcStatusString[ 80 ];
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			pxPeriodic = pxNextTCB->pxPeriodic;
+			if( pxPeriodic != NULL )
+			{
+				sprintf( pcStatusString, ( char * ) "%s\t\t%s\t%u\t%u\t%lu\t%lu\t%u\r\n", pxNextTCB->pcTaskName, ( pxNextTCB->uxPriority == configEDF_PRIORITY ) ? "EDF" : "FP", ( unsigned int ) pxPeriodic->xPeriod, ( unsigned int ) pxPeriodic->xRelativeDeadline, pxPeriodic->ulJobs, pxPeriodic->ulDeadlineMisses, ( unsigned int ) pxPeriodic->xWorstResponse );
+				strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatusString );
+			}
+
+		} while( pxNextTCB != pxFirstTCB );
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime )
@@ -2262,7 +3434,7 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_vTaskWalkStacks == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
 	{
@@ -2319,10 +3491,37 @@ tskTCB *pxNewTCB;
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
+		#if ( configUSE_EDF_SCHEDULING == 1 )
+		{
+			/* Allocated by xTaskSetPeriodic(), also for a static task. */
+			if( pxTCB->pxPeriodic != NULL )
+			{
+				vPortFree( pxTCB->pxPeriodic );
+			}
+		}
+		#endif
+
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
 		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* Memory supplied by the application is left alone. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				vPortFree( pxTCB );
+			}
+		}
+		#else
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#endif
 	}
 
 #endif
@@ -2386,14 +3585,19 @@ tskTCB *pxNewTCB;
 
 		if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
 		{
-			/* Adjust the mutex holder state to account for its new priority. */
-			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			/* Adjust the mutex holder state to account for its new priority,
+			unless the event list item value is in use for something else. */
+			if( taskEVENT_LIST_ITEM_VALUE_IS_FREE( pxTCB ) )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			}
 
 			/* If the task being modified is in the ready state it will need to
 			be moved in to a new list. */
 			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
 			{
 				vListRemove( &( pxTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 				/* Inherit the priority before being moved into the new list. */
 				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
@@ -2425,12 +3629,16 @@ tskTCB *pxNewTCB;
 				/* We must be the running task to be able to give the mutex back.
 				Remove ourselves from the ready list we currently appear in. */
 				vListRemove( &( pxTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 				/* Disinherit the priority before adding the task into the new
 				ready list. */
 				traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
 				pxTCB->uxPriority = pxTCB->uxBasePriority;
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority );
+				if( taskEVENT_LIST_ITEM_VALUE_IS_FREE( pxTCB ) )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority );
+				}
 				prvAddTaskToReadyQueue( pxTCB );
 			}
 		}
@@ -2475,6 +3683,280 @@ void vTaskExitCritical( void )
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockForNotification( portTickType xTicksToWait )
+	{
+		/* The task is going to block.  It must be removed from the ready list
+		first as the same list item is used for the blocked lists.  No event
+		list is involved, the notifying task or interrupt finds the TCB
+		directly. */
+		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Not to be woken by a timeout. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+			}
+		}
+		#else
+		{
+			prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+		}
+		#endif
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvApplyNotification( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction, eNotifyValue eOriginalNotifyState )
+	{
+	portBASE_TYPE xReturn = pdPASS;
+
+		switch( eAction )
+		{
+			case eSetBits :
+				pxTCB->ulNotifiedValue |= ulValue;
+				break;
+
+			case eIncrement :
+				( pxTCB->ulNotifiedValue )++;
+				break;
+
+			case eSetValueWithOverwrite :
+				pxTCB->ulNotifiedValue = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				if( eOriginalNotifyState != eNotified )
+				{
+					pxTCB->ulNotifiedValue = ulValue;
+				}
+				else
+				{
+					/* The value could not be written to the task. */
+					xReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+			default :
+				/* The task is being notified without its notify value being
+				updated. */
+				break;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				pxCurrentTCB->eNotifyState = eWaitingNotification;
+
+				if( xTicksToWait > ( portTickType ) 0U )
+				{
+					prvBlockForNotification( xTicksToWait );
+					traceTASK_NOTIFY_TAKE_BLOCK();
+
+					/* The yield is taken when the critical section is left,
+					and the task resumes here once notified or timed out. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue = ulReturn - 1UL;
+				}
+			}
+
+			pxCurrentTCB->eNotifyState = eNotWaitingNotification;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->eNotifyState != eNotified )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->eNotifyState = eWaitingNotification;
+
+				if( xTicksToWait > ( portTickType ) 0U )
+				{
+					prvBlockForNotification( xTicksToWait );
+					traceTASK_NOTIFY_WAIT_BLOCK();
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_WAIT();
+
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
+
+			/* If eNotifyState is still eWaitingNotification then either the
+			task never blocked or it timed out. */
+			if( pxCurrentTCB->eNotifyState == eWaitingNotification )
+			{
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				/* A notification was already pending or was received while
+				the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->eNotifyState = eNotWaitingNotification;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction )
+	{
+	tskTCB * pxTCB;
+	eNotifyValue eOriginalNotifyState;
+	portBASE_TYPE xReturn;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		taskENTER_CRITICAL();
+		{
+			eOriginalNotifyState = pxTCB->eNotifyState;
+			pxTCB->eNotifyState = eNotified;
+			xReturn = prvApplyNotification( pxTCB, ulValue, eAction, eOriginalNotifyState );
+			traceTASK_NOTIFY();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( eOriginalNotifyState == eWaitingNotification )
+			{
+				vListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+
+				/* The task should not have been on an event list. */
+				configASSERT( pxTCB->xEventListItem.pvContainer == NULL );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB * pxTCB;
+	eNotifyValue eOriginalNotifyState;
+	portBASE_TYPE xReturn;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
 
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			eOriginalNotifyState = pxTCB->eNotifyState;
+			pxTCB->eNotifyState = eNotified;
+			xReturn = prvApplyNotification( pxTCB, ulValue, eAction, eOriginalNotifyState );
+			traceTASK_NOTIFY_FROM_ISR();
 
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( eOriginalNotifyState == eWaitingNotification )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( pxTCB->xEventListItem.pvContainer == NULL );
+
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					vListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyQueue( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		( void ) xTaskNotifyFromISR( xTaskToNotify, 0UL, eIncrement, pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
 
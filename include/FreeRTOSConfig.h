@@ -79,13 +79,136 @@
 #define configTICK_RATE_HZ			( ( portTickType ) 100 )
 #define configMAX_PRIORITIES		( ( unsigned portBASE_TYPE ) 5 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 128 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 10 * 1024 ) )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 8 * 1024 ) )
 #define configMAX_TASK_NAME_LEN		( 16 )
 #define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 #define configUSE_MUTEXES			1
 
+/* Keep a bitmap of the priorities with ready tasks and pick the highest with a
+single CLZ instead of walking down the ready lists, see the bench command. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+
+/* Per task notification values, a lighter alternative to a semaphore or a one
+item queue when a single known task waits, see xTaskNotify() in task.h.  The
+USART driver in main.c uses them, "bench notify" compares the two. */
+#define configUSE_TASK_NOTIFICATIONS	1
+
+/* Single reader, single writer byte streams and length prefixed messages,
+copied in bulk, see stream_buffer.h.  They need the task notifications above.
+The console RX path in main.c uses one, "bench stream" compares them with a
+queue of single bytes. */
+#define configUSE_STREAM_BUFFERS		1
+
+/* uxQueueSendMultiple() and uxQueueReceiveMultiple(), moving several queue
+items per critical section and wake up, see queue.h and "bench batch". */
+#define configUSE_QUEUE_BATCH			1
+
+/* Queue sets, letting one task block on several queues and semaphores at
+once, see queue.h.  fio_poll() is built on them, the shell's "wait" command
+polls stdin with it. */
+#define configUSE_QUEUE_SETS			1
+
+/* Mailboxes passing pool allocated buffers by reference instead of copying
+them through a queue, see mailbox.h and "bench mailbox". */
+#define configUSE_MAILBOXES			1
+
+/* xTaskCreateStatic(), xQueueCreateStatic() and xSemaphoreCreateMutexStatic(),
+creating kernel objects in memory the application supplies.  The CLI and
+Logger tasks, the hrtimer daemon and its queue are static so startup does not
+depend on the state of the heap, see meminfo for what is left allocated.  With
+0 they are taken from the heap instead. */
+#define configSUPPORT_STATIC_ALLOCATION	1
+
+/* Earliest deadline first scheduling for the periodic tasks at
+configEDF_PRIORITY, see xTaskSetPeriodic() in task.h, "ps" and "bench edf".
+Tasks there without a period run ahead of the periodic ones, first come first
+served with no time slicing.  Above the CLI and the Logger, below the daemons
+at the top priority. */
+#define configUSE_EDF_SCHEDULING		1
+#define configEDF_PRIORITY				( configMAX_PRIORITIES - 2 )
+
+/* Mutexes whose uncontended take and give are one LDREX/STREX compare-and-
+swap, falling back to blocking with priority inheritance only when held, see
+fast_mutex.h and "bench mutex".  The fio, dir and ps locks use them. */
+#define configUSE_FAST_MUTEXES			1
+
+/* Event groups, letting any number of tasks wait for any or all of a set of
+event bits and wake together when one call sets them, see event_groups.h and
+"bench events".  Setting bits from an interrupt is deferred to the daemon
+below. */
+#define configUSE_EVENT_GROUPS		1
+
+/* The deferred daemon, which calls the functions interrupt handlers pend with
+xPendFunctionCallFromISR(), see deferred.h and "bench deferred".  The USART
+handler in main.c leaves all but the register accesses to it.  It runs above
+every application task.  Each received byte is one call, the ring covers the
+bytes that arrive while the daemon is held off.  Latencies are counted in
+clock_cycles(). */
+#define configUSE_DEFERRED_CALLS		1
+#define configDEFERRED_TASK_PRIORITY	( configMAX_PRIORITIES - 1 )
+#define configDEFERRED_QUEUE_LENGTH		32
+#ifdef STACK_SIZE_DEFERRED
+#define configDEFERRED_TASK_STACK_DEPTH	STACK_SIZE_DEFERRED
+#else
+#define configDEFERRED_TASK_STACK_DEPTH	configMINIMAL_STACK_SIZE
+#endif
+#define configDEFERRED_TIMESTAMP()		clock_cycles()
+
+/* The timer service task, which also runs the functions pended with
+xTimerPendFunctionCallFromISR().  It runs above every application task so a
+pended function is not delayed behind the work it signals. */
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH		8
+#ifdef STACK_SIZE_TMR_SVC
+#define configTIMER_TASK_STACK_DEPTH	STACK_SIZE_TMR_SVC
+#else
+#define configTIMER_TASK_STACK_DEPTH	configMINIMAL_STACK_SIZE
+#endif
+
+/* File delayed tasks in a timer wheel instead of a list sorted by wake time.
+Blocking with a timeout becomes O(1) whatever the number of blocked tasks, at
+the cost of about 1.3K of RAM for the wheel slots.  With the handful of tasks
+this system runs the sorted list is as fast, see "bench delay". */
+#define configUSE_DELAYED_TASK_WHEEL	0
+
+/* Let the idle task stop the tick and sleep until the next task is due instead
+of waking every tick, see vPortSuppressTicksAndSleep() in the ARM_CM3 port.
+A 24-bit SysTick at 72MHz covers at most 23 ticks per sleep. */
+#define configUSE_TICKLESS_IDLE		1
+
+/* Serve small allocations from fixed size pools in front of the heap, see
+portable/MemMang/slab.c.  The pools take about 2K, which is why the heap above
+is smaller than the 10K it used to be.  configTOTAL_HEAP_SIZE only sizes the
+array based heaps, heap_5 (the default) takes all RAM the image leaves free. */
+#define configUSE_SLAB_ALLOCATOR	1
+
+/* Count allocations per call site and track the heap high water mark for the
+meminfo and heapmap commands, see include/heapstats.h. */
+#define configUSE_HEAP_INSTRUMENTATION	1
+
+/* Microsecond one-shot and periodic timers on TIM2, their callbacks run in a
+daemon task at the top priority, see include/hrtimer.h and "bench
+hrtimer".  The kernel software timers above stay tick based. */
+#define configUSE_HRTIMER			1
+
+/* PROFILE_BEGIN()/PROFILE_END() code regions, see include/profile.h and
+"prof regions".  Release builds, make RELEASE=1, define NDEBUG, which compiles
+them out, see mk/release.mk. */
+#ifdef NDEBUG
+#define configUSE_PROFILER			0
+#else
+#define configUSE_PROFILER			1
+#endif
+
+/* Check on every context switch that the task switched out stayed within its
+stack, both its stack pointer and the last 16 bytes of the fill pattern, see
+vApplicationStackOverflowHook() in main.c.  The "stacks" command reports the
+high water marks, it needs vTaskWalkStacks() below. */
+#define configCHECK_FOR_STACK_OVERFLOW	2
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
@@ -100,6 +223,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTimerPendFunctionCall	1
+#define INCLUDE_vTaskWalkStacks			1
 
 /* This is the raw value as per the Cortex-M3 NVIC.  Values can be 255
 (lowest) to 0 (1?) (highest). */
@@ -113,5 +238,31 @@ configKERNEL_INTERRUPT_PRIORITY setting.  Here 15 corresponds to the lowest
 NVIC value of 255. */
 #define configLIBRARY_KERNEL_INTERRUPT_PRIORITY	15
 
+/* Record kernel events into the RAM trace ring, see include/trace.h.  Needs
+configUSE_TRACE_FACILITY for the task numbers. */
+#define configUSE_TRACE_RECORDER		1
+
+/* clock_cycles() and clock_now_us(), timestamps finer than the tick for the
+trace recorder, the benchmarks and the logger, see include/clock.h. */
+#include "clock.h"
+
+/* With the profiler, also time the outermost critical sections and scheduler
+suspensions and report the longest per caller, see include/latency.h and
+"prof latency". */
+#if ( configUSE_PROFILER == 1 )
+	#include "latency.h"
+#endif
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+	#include "heapstats.h"
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+	#if ( configUSE_TRACE_FACILITY != 1 )
+		#error configUSE_TRACE_RECORDER requires configUSE_TRACE_FACILITY
+	#endif
+	#include "trace.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
 
@@ -0,0 +1,44 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+/* Monotonic clock finer than the tick.
+ *
+ * The tick interrupts counted since the scheduler started, scaled by the
+ * SysTick period, plus the counts SysTick has gone through in the current
+ * period.  Readings are modulo 2^32 and consistent across that wrap and the
+ * tick count's own, so the difference of two readings is right as long as
+ * it is under 59s in cycles or 71 minutes in microseconds.  Both can be
+ * called from tasks, interrupts and critical sections.
+ *
+ * Tickless idle stretches the SysTick period while it sleeps, readings taken
+ * during or just after a sleep can be off by up to a tick.
+ *
+ * Like trace.h this is included from the end of FreeRTOSConfig.h and must
+ * not include any kernel header.
+ */
+
+/* CPU cycles, wraps every 59s at 72MHz. */
+unsigned long clock_cycles(void);
+
+/* Microseconds, wraps every 71 minutes. */
+unsigned long clock_now_us(void);
+
+/* Seconds, with the microseconds into the second in *us, for timestamps
+ * that must outlast clock_now_us().  Wraps with the tick count, after 497
+ * days at 100Hz. */
+unsigned long clock_now_s(unsigned long *us);
+
+/* A clock_cycles() difference in microseconds. */
+#define clock_cycles_to_us(cycles) \
+    ((cycles) / (configCPU_CLOCK_HZ / 1000000UL))
+
+void clock_tick(void);
+void clock_step_ticks(unsigned long ticks);
+
+/* Kernel hooks: count the tick before anything in its interrupt reads the
+ * clock, and the ticks tickless idle slept through. */
+#define traceTICK_ENTER() clock_tick()
+#define traceINCREASE_TICK_COUNT(xTicksToJump) \
+    clock_step_ticks((unsigned long) (xTicksToJump))
+
+#endif
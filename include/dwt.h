@@ -0,0 +1,30 @@
+#ifndef DWT_H
+#define DWT_H
+
+#include "stm32f10x.h"
+
+/* The DWT cycle counter, counting CPU cycles once started whatever the
+ * SysTick and the scheduler are doing.  Used by the profiler and for the boot
+ * time "meminfo" reports.
+ */
+
+/* Not in this version of core_cm3.h. */
+#define DWT_CTRL   (*(volatile unsigned long *) 0xe0001000)
+#define DWT_CYCCNT (*(volatile unsigned long *) 0xe0001004)
+#define DWT_CTRL_CYCCNTENA 1UL
+
+/* Starts the counter, if stopped, and returns whether it counts.  Some cores
+ * and emulators do not implement it, the register then stays 0. */
+static inline int dwt_start(void)
+{
+    unsigned long start;
+    volatile int i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    start = DWT_CYCCNT;
+    for (i = 0; i < 16; i++);
+    return DWT_CYCCNT != start;
+}
+
+#endif
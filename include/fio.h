@@ -2,6 +2,8 @@
 #define __FIO_H__
 
 #include <stdio.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
 
 enum open_types_t {
     O_RDONLY = 0,
@@ -14,17 +16,37 @@ enum open_types_t {
 
 #define MAX_FDS 32
 
+/* Descriptors fio_poll() takes at once, and tasks that can be in it at once. */
+#define FIO_POLL_MAX 8
+#define FIO_POLL_TASKS 2
+
+/* fio_pollfd events and revents bits */
+#define FIO_POLLIN   1  /* a read would not block */
+#define FIO_POLLNVAL 2  /* the descriptor is not open */
+
 typedef ssize_t (*fdread_t)(void * opaque, void * buf, size_t count);
 typedef ssize_t (*fdwrite_t)(void * opaque, const void * buf, size_t count);
 typedef off_t (*fdseek_t)(void * opaque, off_t offset, int whence);
 typedef int (*fdclose_t)(void * opaque);
 
+/* Returns nonzero if a read would not block.  Otherwise it may set *event to
+ * a binary semaphore that is given whenever the descriptor may have become
+ * readable, taken before checking so that no change is missed. */
+typedef int (*fdpoll_t)(void * opaque, xSemaphoreHandle * event);
+
 struct fddef_t {
     fdread_t fdread;
     fdwrite_t fdwrite;
     fdseek_t fdseek;
     fdclose_t fdclose;
     void * opaque;
+    fdpoll_t fdpoll;
+};
+
+struct fio_pollfd {
+    int fd;
+    int events;
+    int revents;
 };
 
 
@@ -38,6 +60,8 @@ ssize_t fio_write(int fd, const void * buf, size_t count);
 off_t fio_seek(int fd, off_t offset, int whence);
 int fio_close(int fd);
 void fio_set_opaque(int fd, void * opaque);
+void fio_set_poll(int fd, fdpoll_t fdpoll);
+int fio_poll(struct fio_pollfd * fds, int n, int timeout);
 
 void register_devfs();
 
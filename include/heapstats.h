@@ -0,0 +1,39 @@
+#ifndef HEAPSTATS_H
+#define HEAPSTATS_H
+
+#include <stddef.h>
+
+/* Heap instrumentation.
+ *
+ * Hooked into traceMALLOC()/traceFREE() when configUSE_HEAP_INSTRUMENTATION
+ * is 1.  Allocations are attributed to the return address of pvPortMalloc(),
+ * look the addresses printed by "meminfo" up with addr2line.  Like trace.h
+ * this is included from the end of FreeRTOSConfig.h and must not include any
+ * kernel header.
+ */
+
+/* Distinct call sites tracked, later ones are counted as "other". */
+#define HEAPSTATS_CALL_SITES 16
+
+void heapstats_malloc(void *p, size_t size, void *caller);
+void heapstats_free(void *p, size_t size);
+
+/* Starts the DWT cycle counter, the first thing main() does, so that
+ * heapstats_boot() can tell how many cycles startup took. */
+void heapstats_boot_start(void);
+
+/* Records the heap use main() leaves behind and the cycles spent since
+ * heapstats_boot_start(), called just before it starts the scheduler and
+ * reported by "meminfo". */
+void heapstats_boot(void);
+
+/* While held the hooks return straight away, so "mmtest" times the allocator
+ * without the bookkeeping and its churn stays out of the meminfo counts. */
+void heapstats_hold(int hold);
+
+#define traceMALLOC(pvAddress, uiSize) \
+    heapstats_malloc((pvAddress), (uiSize), __builtin_return_address(0))
+#define traceFREE(pvAddress, uiSize) \
+    heapstats_free((pvAddress), (uiSize))
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+/* High resolution timers on TIM2.
+ *
+ * TIM2 counts microseconds, extended to 32 bits by its update interrupt, so
+ * deadlines are not tied to the 10ms tick.  Pending timers are kept in a
+ * min-heap ordered by deadline and the compare channel is armed for the
+ * earliest one.  The interrupt only moves expired timers to a queue, their
+ * callbacks run in the "HRT" daemon task at the top priority, where they may
+ * call the kernel like any task.  Periodic timers are re-armed from their
+ * previous deadline, so late callbacks do not accumulate drift.
+ *
+ * Times wrap every 71 minutes, delays and periods must stay below half that.
+ */
+
+/* Timers pending at once. */
+#define HRTIMER_MAX 16
+
+struct hrtimer;
+
+typedef void (*hrtimer_callback)(struct hrtimer *timer, void *arg);
+
+/* Owned by the caller, which must not touch the fields while the timer is
+ * pending. */
+struct hrtimer {
+    unsigned long deadline;     /* hrtimer_now() of the next expiry */
+    unsigned long period;       /* microseconds, 0 for a one-shot timer */
+    hrtimer_callback callback;
+    void *arg;
+    int index;                  /* in the heap, -1 when not pending */
+    unsigned long overruns;     /* expiries lost to a full daemon queue */
+};
+
+/* Latencies in microseconds past the deadline, see hrtimer_stats(). */
+struct hrtimer_latency {
+    unsigned long count;
+    unsigned long total;
+    unsigned long min;
+    unsigned long max;
+};
+
+/* Sets up TIM2 and the daemon, called by main() before the scheduler
+ * starts. */
+void hrtimer_init(void);
+
+/* Microseconds since hrtimer_init(), callable from any context. */
+unsigned long hrtimer_now(void);
+
+/* Calls callback(timer, arg) from the daemon delay microseconds from now,
+ * then every period microseconds unless period is 0.  A pending timer is
+ * restarted.  Returns 0 if HRTIMER_MAX timers are already pending. */
+int hrtimer_start(struct hrtimer *timer, unsigned long delay,
+                  unsigned long period, hrtimer_callback callback, void *arg);
+
+/* Returns 1 if the timer was pending.  An expiry already passed to the
+ * daemon still runs. */
+int hrtimer_cancel(struct hrtimer *timer);
+
+/* Deadline to interrupt and deadline to callback latencies since the last
+ * reset, either may be NULL. */
+void hrtimer_stats(struct hrtimer_latency *isr, struct hrtimer_latency *callback,
+                   int reset);
+
+#endif
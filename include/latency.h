@@ -0,0 +1,52 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/* Critical section and scheduler suspension latency.
+ *
+ * Hooked into the port's vPortEnterCritical()/vPortExitCritical() and into
+ * vTaskSuspendAll()/xTaskResumeAll() when configUSE_PROFILER is 1.  Only the
+ * outermost level of each is timed, from the entry that masks interrupts or
+ * suspends the scheduler to the exit that undoes it, and the interval is
+ * attributed to the return address of that entry.  "prof latency" lists the
+ * callers by their longest interval, look the addresses up with addr2line.
+ *
+ * Masking done directly with taskDISABLE_INTERRUPTS() or from interrupts
+ * with portSET_INTERRUPT_MASK_FROM_ISR() is not seen.  Like trace.h this is
+ * included from the end of FreeRTOSConfig.h and must not include any kernel
+ * header.
+ */
+
+/* Distinct callers tracked per kind, later ones are counted as "other". */
+#define LATENCY_CALL_SITES 16
+
+void latency_critical_enter(void *caller);
+void latency_critical_exit(void);
+void latency_suspend_enter(void *caller);
+void latency_suspend_exit(void);
+
+/* Prints the report for "prof latency", resets it for "prof reset". */
+void latency_prof_report(void);
+void latency_prof_reset(void);
+
+#define traceCRITICAL_ENTER(uxNesting) \
+    do { \
+        if ((uxNesting) == 1) \
+            latency_critical_enter(__builtin_return_address(0)); \
+    } while (0)
+#define traceCRITICAL_EXIT(uxNesting) \
+    do { \
+        if ((uxNesting) == 0) \
+            latency_critical_exit(); \
+    } while (0)
+#define traceSUSPEND_ALL(uxNesting) \
+    do { \
+        if ((uxNesting) == 1) \
+            latency_suspend_enter(__builtin_return_address(0)); \
+    } while (0)
+#define traceRESUME_ALL(uxNesting) \
+    do { \
+        if ((uxNesting) == 0) \
+            latency_suspend_exit(); \
+    } while (0)
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "FreeRTOS.h"
+
+/* Code region profiling.
+ *
+ * PROFILE_BEGIN(id) and PROFILE_END(id) bracket a region within one block,
+ * with PROFILE_END() before every return that leaves it.  id is one of the
+ * names in PROFILE_REGIONS below.  Each pass adds its cycles to the count,
+ * total, min, max and power of two histogram of the region, all in static
+ * storage, reported by "prof regions".  Cycles come from the DWT cycle
+ * counter when the core runs one, from clock_cycles() otherwise.
+ *
+ * The macros compile to nothing unless configUSE_PROFILER is 1, which
+ * FreeRTOSConfig.h turns off in release builds (make RELEASE=1, which
+ * defines NDEBUG).
+ */
+
+#define PROFILE_REGIONS(X) \
+    X(fs_open) \
+    X(romfs_get_file_by_hash) \
+    X(refresh_line) \
+    X(usart2_isr)
+
+#define PROFILE_ENUM(id) PROFILE_##id,
+enum profile_region {
+    PROFILE_REGIONS(PROFILE_ENUM)
+    PROFILE_REGION_COUNT
+};
+#undef PROFILE_ENUM
+
+/* histogram[i] counts passes of 2^i up to 2^(i+1)-1 cycles, 0 in [0]. */
+#define PROFILE_BUCKETS 32
+
+struct profile_stats {
+    unsigned long count;
+    unsigned long total;
+    unsigned long min;
+    unsigned long max;
+    unsigned long histogram[PROFILE_BUCKETS];
+};
+
+#if configUSE_PROFILER == 1
+
+unsigned long profile_cycles(void);
+void profile_record(enum profile_region region, unsigned long cycles);
+
+#define PROFILE_BEGIN(id) \
+    unsigned long profile_start_##id = profile_cycles()
+#define PROFILE_END(id) \
+    profile_record(PROFILE_##id, profile_cycles() - profile_start_##id)
+
+#else
+
+#define PROFILE_BEGIN(id) do { } while (0)
+#define PROFILE_END(id) do { } while (0)
+
+#endif
+
+#endif
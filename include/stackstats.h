@@ -0,0 +1,15 @@
+#ifndef STACKSTATS_H
+#define STACKSTATS_H
+
+/* Stack high water marks, reported by the "stacks" command.
+ *
+ * Task stacks are filled with a known byte when they are created, the main
+ * stack is painted the same way by stackstats_paint_msp().  "stacks save"
+ * writes the recommended depths to a header, build with
+ * make STACK_SIZES=output/stack_sizes.h to use them.
+ */
+
+/* Fills the unused part of the main stack, the first thing main() does. */
+void stackstats_paint_msp(void);
+
+#endif
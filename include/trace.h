@@ -0,0 +1,131 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/* Kernel trace recorder.
+ *
+ * The FreeRTOS trace macros are mapped onto trace_record(), which appends a
+ * compact 8-byte event to a RAM ring.  The ring is either written to the host
+ * through semihosting ("trace dump") or pulled out with gdb ("tracedump" in
+ * tool/gdbscript), then converted to Chrome trace JSON by tool/trace2json.
+ *
+ * This header is included from the end of FreeRTOSConfig.h, so it must not
+ * include any kernel header itself.
+ */
+
+#define TRACE_MAGIC      0x52545246 /* "FRTR" */
+#define TRACE_VERSION    1
+#define TRACE_NAME_LEN   16
+#define TRACE_MAX_TASKS  16
+
+/* Number of events kept in the ring, must be a power of two. */
+#ifndef TRACE_BUFFER_EVENTS
+#define TRACE_BUFFER_EVENTS 256
+#endif
+
+enum trace_event_type {
+    TRACE_TASK_SWITCHED_IN = 1,
+    TRACE_TASK_SWITCHED_OUT,
+    TRACE_TASK_CREATE,
+    TRACE_TASK_DELETE,
+    TRACE_TASK_DELAY,
+    TRACE_TASK_DELAY_UNTIL,
+    TRACE_TASK_READY,
+    TRACE_TASK_SUSPEND,
+    TRACE_TASK_RESUME,
+    TRACE_TASK_PRIORITY_INHERIT,
+    TRACE_TASK_PRIORITY_DISINHERIT,
+    TRACE_QUEUE_SEND,
+    TRACE_QUEUE_SEND_FAILED,
+    TRACE_QUEUE_RECEIVE,
+    TRACE_QUEUE_RECEIVE_FAILED,
+    TRACE_QUEUE_SEND_FROM_ISR,
+    TRACE_QUEUE_RECEIVE_FROM_ISR,
+    TRACE_BLOCKING_ON_QUEUE_SEND,
+    TRACE_BLOCKING_ON_QUEUE_RECEIVE,
+    TRACE_ISR_ENTER,
+    TRACE_ISR_EXIT,
+};
+
+struct trace_event {
+    unsigned long timestamp; /* CPU cycles, wraps every ~60s at 72MHz */
+    unsigned char type;      /* enum trace_event_type */
+    unsigned char task;      /* uxTCBNumber of the running task */
+    unsigned short object;   /* task number, queue address >> 2 or IRQ */
+};
+
+/* Layout dumped to the host, read back by tool/trace2json. */
+struct trace_buffer {
+    unsigned long magic;
+    unsigned long version;
+    unsigned long cpu_hz;
+    unsigned long capacity;
+    unsigned long head;      /* total number of events ever recorded */
+    char names[TRACE_MAX_TASKS][TRACE_NAME_LEN];   /* by task number */
+    struct trace_event events[TRACE_BUFFER_EVENTS];
+};
+
+extern struct trace_buffer trace_buffer;
+
+void trace_record(unsigned char type, unsigned short object);
+void trace_task_switched_in(unsigned char task);
+void trace_task_create(unsigned char task, const char *name);
+void trace_isr_enter(void);
+void trace_isr_exit(void);
+
+void trace_start(void);
+void trace_stop(void);
+int trace_is_enabled(void);
+int trace_dump(const char *filename);
+unsigned long trace_overhead(void);
+
+#define trace_object(p) ((unsigned short) ((unsigned long) (p) >> 2))
+
+/* Kernel hooks, see FreeRTOS.h for where each one fires. */
+#define traceTASK_SWITCHED_IN() \
+    trace_task_switched_in((unsigned char) pxCurrentTCB->uxTCBNumber)
+#define traceTASK_SWITCHED_OUT() \
+    trace_record(TRACE_TASK_SWITCHED_OUT, 0)
+#define traceTASK_CREATE(pxNewTCB) \
+    trace_task_create((unsigned char) (pxNewTCB)->uxTCBNumber, \
+                      (const char *) (pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTCB) \
+    trace_record(TRACE_TASK_DELETE, (unsigned short) (pxTCB)->uxTCBNumber)
+#define traceTASK_DELAY() \
+    trace_record(TRACE_TASK_DELAY, 0)
+#define traceTASK_DELAY_UNTIL() \
+    trace_record(TRACE_TASK_DELAY_UNTIL, 0)
+/* prvAddTaskToReadyQueue() does not terminate this one with a semicolon. */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    trace_record(TRACE_TASK_READY, (unsigned short) (pxTCB)->uxTCBNumber);
+#define traceTASK_SUSPEND(pxTCB) \
+    trace_record(TRACE_TASK_SUSPEND, (unsigned short) (pxTCB)->uxTCBNumber)
+#define traceTASK_RESUME(pxTCB) \
+    trace_record(TRACE_TASK_RESUME, (unsigned short) (pxTCB)->uxTCBNumber)
+#define traceTASK_RESUME_FROM_ISR(pxTCB) \
+    trace_record(TRACE_TASK_RESUME, (unsigned short) (pxTCB)->uxTCBNumber)
+#define traceTASK_PRIORITY_INHERIT(pxTCB, uxPriority) \
+    trace_record(TRACE_TASK_PRIORITY_INHERIT, (unsigned short) (pxTCB)->uxTCBNumber)
+#define traceTASK_PRIORITY_DISINHERIT(pxTCB, uxPriority) \
+    trace_record(TRACE_TASK_PRIORITY_DISINHERIT, (unsigned short) (pxTCB)->uxTCBNumber)
+
+#define traceQUEUE_SEND(pxQueue) \
+    trace_record(TRACE_QUEUE_SEND, trace_object(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    trace_record(TRACE_QUEUE_SEND_FAILED, trace_object(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) \
+    trace_record(TRACE_QUEUE_RECEIVE, trace_object(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    trace_record(TRACE_QUEUE_RECEIVE_FAILED, trace_object(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    trace_record(TRACE_QUEUE_SEND_FROM_ISR, trace_object(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    trace_record(TRACE_QUEUE_RECEIVE_FROM_ISR, trace_object(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    trace_record(TRACE_BLOCKING_ON_QUEUE_SEND, trace_object(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    trace_record(TRACE_BLOCKING_ON_QUEUE_RECEIVE, trace_object(pxQueue))
+
+#define traceISR_ENTER() trace_isr_enter()
+#define traceISR_EXIT()  trace_isr_exit()
+
+#endif
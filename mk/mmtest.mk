@@ -0,0 +1,20 @@
+MMBENCH_HEAPS ?= heap_1 heap_2 heap_3 heap_5 heap_ww heap_tlsf
+MMBENCH_SEED ?=
+MMBENCH_BIN = $(addprefix $(OUTDIR)/host/mmtest-,$(MMBENCH_HEAPS))
+MEMMANG_SRC = $(FREERTOS_SRC)/portable/MemMang
+
+# Replay the mmtest traces on the host against every heap implementation.
+# Timings are in ns here, "mmtest" in the shell reports target cycles.  The
+# linker symbols heap_5 falls back on are dummies, the host defines a region.
+mmbench: $(MMBENCH_BIN)
+	@for bin in $^; do \
+		echo "== $${bin##*/mmtest-}"; \
+		$$bin $(MMBENCH_SEED) | tr -d '\r'; \
+	done
+
+$(OUTDIR)/host/mmtest-%: src/mmtest.c src/heapstats.c $(TOOLDIR)/mmtest-host.c \
+		$(MEMMANG_SRC)/%.c $(MEMMANG_SRC)/slab.c
+	@mkdir -p $(dir $@)
+	@echo "    CC      "$@
+	@gcc -O2 -no-pie -w -DMMTEST_HOST $(INCLUDES) -o $@ $^ \
+		-Wl,--defsym,_sheap=0 -Wl,--defsym,_eheap=0
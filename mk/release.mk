@@ -0,0 +1,7 @@
+# Release build, make RELEASE=1.  Defines NDEBUG, which turns off
+# configUSE_PROFILER and with it the PROFILE_BEGIN()/PROFILE_END() regions and
+# the critical section timing.  Objects built without it are not rebuilt, run
+# make clean first.
+ifdef RELEASE
+CFLAGS += -DNDEBUG
+endif
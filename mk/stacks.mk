@@ -0,0 +1,8 @@
+# Build with the stack depths "stacks save" wrote on an earlier run, e.g.
+# make STACK_SIZES=output/stack_sizes.h.  Tasks the header does not name keep
+# their defaults, the main stack size is passed on to main.ld.  Objects built
+# without it are not rebuilt, run make clean first.
+ifdef STACK_SIZES
+CFLAGS += -include $(STACK_SIZES) \
+		  -Wl,--defsym,_Main_Stack_Size=$(shell sed -n 's/.*MAIN_STACK_SIZE \([0-9][0-9]*\).*/\1/p' $(STACK_SIZES))
+endif
@@ -0,0 +1,11 @@
+TRACE_DUMP ?= output/trace.bin
+
+# Convert a recorder dump ("trace dump" in the shell, or "tracedump" in gdb)
+# into Chrome trace JSON, open the result in chrome://tracing.
+tracejson: $(OUTDIR)/$(TOOLDIR)/trace2json
+	$(OUTDIR)/$(TOOLDIR)/trace2json $(TRACE_DUMP) $(TRACE_DUMP:.bin=.json)
+
+$(OUTDIR)/%/trace2json: %/trace2json.c
+	@mkdir -p $(dir $@)
+	@echo "    CC      "$@
+	@gcc -Wall -o $@ $^
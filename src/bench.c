@@ -0,0 +1,1353 @@
+#include "stm32f10x.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "mailbox.h"
+#include "event_groups.h"
+#include "fast_mutex.h"
+#include "deferred.h"
+#include "hrtimer.h"
+
+#include "clib.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Kernel micro benchmarks, run one with "bench <name>".
+ *
+ * Times are CPU cycles read with clock_cycles(), which keeps counting across
+ * ticks; a section that spans a tick interrupt includes it and only shows up
+ * in max. */
+
+#define BENCH_ROUNDS 1000
+
+/* Sleepers for "bench delay", and how long they sleep.  The timed task waits
+ * longer than any of them, which is the worst case for the sorted list. */
+#define DELAY_SLEEPERS_MAX 200
+#define DELAY_SLEEPER_STACK 48
+#define DELAY_SLEEP_TICKS 500
+#define DELAY_TIMEOUT_TICKS 1000
+
+/* Bytes moved per "bench stream" run, the largest transfer, and the capacity
+ * of the queue or buffer they go through. */
+#define STREAM_BYTES 16384
+#define STREAM_CHUNK_MAX 256
+#define STREAM_CAPACITY 512
+
+/* Records moved per "bench batch" run, the largest batch, and the length of
+ * the queue they go through. */
+#define BATCH_RECORDS 4096
+#define BATCH_MAX 64
+#define BATCH_QUEUE_LENGTH 64
+
+/* Payloads moved per "bench mailbox" run, and how many fit in the queue or
+ * the mailbox pool at once. */
+#define MAILBOX_TRANSFERS 1000
+#define MAILBOX_DEPTH 2
+
+/* Wake ups per "bench events" step, the most waiters woken at once, and the
+ * stack of each waiter. */
+#define EVENTS_ROUNDS 200
+#define EVENTS_WAITERS_MAX 8
+#define EVENTS_WAITER_STACK 64
+
+/* Expiries per "bench hrtimer" run, the default period in microseconds, and
+ * the busy loop each load task runs inside a critical section. */
+#define HRTIMER_EXPIRIES 1000
+#define HRTIMER_PERIOD 1000
+#define HRTIMER_LOAD_SPIN 200
+#define HRTIMER_LOAD_STACK 64
+
+/* Stack of each task in the contended "bench mutex" runs. */
+#define MUTEX_TASK_STACK 96
+
+/* Ticks each "bench edf" task set runs for, six of its hyperperiods, the
+ * stack of its tasks, and the gap between two reads of the cycle counter
+ * taken to mean the spinning task was preempted. */
+#define EDF_RUN_TICKS 210
+#define EDF_TASK_STACK 96
+#define EDF_PREEMPT_GAP 2000
+
+/* Capacity of the stream buffer "bench deferred" passes bytes through, one at
+ * a time. */
+#define DEFER_STREAM_BYTES 16
+
+struct bench_result {
+    unsigned long count;
+    unsigned long total;
+    unsigned long min;
+    unsigned long max;
+};
+
+struct bench {
+    const char *name;
+    void (*run)(int n, char *argv[]);
+    const char *desc;
+};
+
+static void bench_reset(struct bench_result *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->min = ~0UL;
+}
+
+static void bench_record(struct bench_result *r, unsigned long cycles)
+{
+    r->count++;
+    r->total += cycles;
+    if (cycles < r->min)
+        r->min = cycles;
+    if (cycles > r->max)
+        r->max = cycles;
+}
+
+/* Ends the line the caller started with its label. */
+static void bench_print(const struct bench_result *r)
+{
+    if (r->count == 0) {
+        fio_printf(1, "no samples\r\n");
+        return;
+    }
+    fio_printf(1, "min %5lu  avg %5lu  max %6lu\r\n",
+               r->min, r->total / r->count, r->max);
+}
+
+/* Context switch round trip.  A task at priority 1 keeps giving a semaphore
+ * that a task at a higher priority waits on.  Each round the high task
+ * blocks, the kernel selects the low task, the give readies the high task and
+ * the kernel switches back.  Without configUSE_PORT_OPTIMISED_TASK_SELECTION
+ * the first selection walks every empty ready list between the two, so the
+ * cost grows with the priority gap; with the bitmap it does not.
+ *
+ * The high task waits with the timeout passed as its parameter.  With
+ * portMAX_DELAY it goes on the suspended list, with a finite timeout it is
+ * also filed among the delayed tasks, see bench_delay(). */
+
+static xSemaphoreHandle ctx_wake;
+static xSemaphoreHandle ctx_done;
+static struct bench_result ctx_result;
+
+static void ctx_low_task(void *pvParameters)
+{
+    for (;;)
+        xSemaphoreGive(ctx_wake);
+}
+
+static void ctx_high_task(void *pvParameters)
+{
+    portTickType timeout = (portTickType) pvParameters;
+    unsigned long start;
+    int i;
+
+    xSemaphoreTake(ctx_wake, 0);
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        start = clock_cycles();
+        xSemaphoreTake(ctx_wake, timeout);
+        bench_record(&ctx_result, clock_cycles() - start);
+    }
+
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+static int ctx_init(void)
+{
+    if (!ctx_wake)
+        vSemaphoreCreateBinary(ctx_wake);
+    if (!ctx_done) {
+        vSemaphoreCreateBinary(ctx_done);
+        if (ctx_done)
+            xSemaphoreTake(ctx_done, 0);
+    }
+    if (!ctx_wake || !ctx_done) {
+        fio_printf(2, "bench: out of memory\r\n");
+        return 0;
+    }
+    return 1;
+}
+
+/* Runs one round trip measurement into ctx_result, 0 if out of memory. */
+static int ctx_run(unsigned portBASE_TYPE priority, portTickType timeout)
+{
+    xTaskHandle low, high;
+
+    bench_reset(&ctx_result);
+
+    if (xTaskCreate(ctx_low_task, (signed portCHAR *) "ctx-lo",
+                    configMINIMAL_STACK_SIZE, NULL, 1, &low) != pdPASS) {
+        fio_printf(2, "bench: out of memory\r\n");
+        return 0;
+    }
+    if (xTaskCreate(ctx_high_task, (signed portCHAR *) "ctx-hi",
+                    configMINIMAL_STACK_SIZE, (void *) timeout, priority,
+                    &high) != pdPASS) {
+        vTaskDelete(low);
+        fio_printf(2, "bench: out of memory\r\n");
+        return 0;
+    }
+
+    xSemaphoreTake(ctx_done, portMAX_DELAY);
+    vTaskDelete(high);
+    vTaskDelete(low);
+    return 1;
+}
+
+static void bench_ctx(int n, char *argv[])
+{
+    unsigned portBASE_TYPE priority;
+
+    if (!ctx_init())
+        return;
+
+    fio_printf(1, "Task selection: %s, %d priorities\r\n",
+               configUSE_PORT_OPTIMISED_TASK_SELECTION ? "bitmap" : "list scan",
+               (int) configMAX_PRIORITIES);
+
+    for (priority = 2; priority < configMAX_PRIORITIES; priority++) {
+        if (!ctx_run(priority, portMAX_DELAY))
+            return;
+
+        fio_printf(1, "round trip, gap %d  ", (int) priority - 1);
+        bench_print(&ctx_result);
+    }
+}
+
+/* Blocking with a timeout vs the number of blocked tasks.  Sleepers are
+ * added in steps, each one blocked in vTaskDelay() with its own wake time,
+ * and the ctx round trip is repeated with a timeout longer than all of
+ * theirs.  The sorted delayed list walks past every sleeper on each block,
+ * the timer wheel (configUSE_DELAYED_TASK_WHEEL) does not.  The portMAX_DELAY
+ * line is the round trip without any delayed list insertion. */
+
+static xTaskHandle delay_sleepers[DELAY_SLEEPERS_MAX];
+
+static void delay_sleeper_task(void *pvParameters)
+{
+    portTickType ticks = DELAY_SLEEP_TICKS + (portTickType) pvParameters;
+
+    for (;;)
+        vTaskDelay(ticks);
+}
+
+static void bench_delay(int n, char *argv[])
+{
+    static const int steps[] = { 5, 10, 25, 50, 100, 150, DELAY_SLEEPERS_MAX };
+    unsigned int i;
+    int sleepers = 0;
+
+    if (!ctx_init())
+        return;
+
+    fio_printf(1, "Delayed tasks: %s\r\n",
+               configUSE_DELAYED_TASK_WHEEL ? "timer wheel" : "sorted list");
+    if (!ctx_run(2, portMAX_DELAY))
+        return;
+    fio_printf(1, "no timeout    ");
+    bench_print(&ctx_result);
+
+    for (i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        /* Sleepers run at the top priority so each blocks as soon as it is
+         * created. */
+        for (; sleepers < steps[i]; sleepers++) {
+            if (xTaskCreate(delay_sleeper_task, (signed portCHAR *) "sleep",
+                            DELAY_SLEEPER_STACK, (void *) sleepers,
+                            configMAX_PRIORITIES - 1,
+                            &delay_sleepers[sleepers]) != pdPASS)
+                break;
+        }
+        if (sleepers < steps[i]) {
+            fio_printf(2, "bench: out of memory at %d sleepers\r\n", sleepers);
+            break;
+        }
+
+        if (!ctx_run(2, DELAY_TIMEOUT_TICKS))
+            break;
+        fio_printf(1, "blocked %3d   ", sleepers);
+        bench_print(&ctx_result);
+    }
+
+    while (sleepers > 0)
+        vTaskDelete(delay_sleepers[--sleepers]);
+}
+
+#if configUSE_TASK_NOTIFICATIONS == 1 \
+    || (configUSE_DEFERRED_CALLS == 1 && configUSE_STREAM_BUFFERS == 1)
+/* Interrupt benchmarks.  A task at priority 1 pends the EXTI0 interrupt from
+ * software and a task at priority 3 waits for whatever the handler does about
+ * it, the time from pending the interrupt to that task running again is
+ * recorded into ctx_result.  Each benchmark supplies the handler action and
+ * the wait.  Nothing else uses EXTI0, the handler only acts while one of them
+ * runs. */
+
+static void (*irq_action)(signed portBASE_TYPE *woken);
+static void (*irq_wait)(void);
+static xTaskHandle irq_waiter;
+static volatile unsigned long irq_start;
+
+void EXTI0_IRQHandler(void)
+{
+    signed portBASE_TYPE woken = pdFALSE;
+
+    if (irq_action)
+        irq_action(&woken);
+    portEND_SWITCHING_ISR(woken);
+}
+
+static void irq_trigger_task(void *pvParameters)
+{
+    /* The waiter has the higher priority, so it is blocked whenever this
+     * task runs. */
+    for (;;) {
+        irq_start = clock_cycles();
+        NVIC_SetPendingIRQ(EXTI0_IRQn);
+    }
+}
+
+static void irq_wait_task(void *pvParameters)
+{
+    int i;
+
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        irq_wait();
+        bench_record(&ctx_result, clock_cycles() - irq_start);
+    }
+
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+/* Runs one interrupt measurement into ctx_result, 0 if out of memory. */
+static int irq_run(void (*action)(signed portBASE_TYPE *), void (*wait)(void))
+{
+    xTaskHandle trigger;
+    int ok = 0;
+
+    bench_reset(&ctx_result);
+    irq_wait = wait;
+
+    /* The handler calls the kernel, so it must not preempt it. */
+    NVIC_SetPriority(EXTI0_IRQn, configLIBRARY_KERNEL_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(EXTI0_IRQn);
+    NVIC_EnableIRQ(EXTI0_IRQn);
+
+    if (xTaskCreate(irq_wait_task, (signed portCHAR *) "irq-wait",
+                    configMINIMAL_STACK_SIZE, NULL, 3, &irq_waiter) != pdPASS) {
+        fio_printf(2, "bench: out of memory\r\n");
+    } else {
+        irq_action = action;
+        if (xTaskCreate(irq_trigger_task, (signed portCHAR *) "irq-trig",
+                        configMINIMAL_STACK_SIZE, NULL, 1, &trigger) != pdPASS) {
+            fio_printf(2, "bench: out of memory\r\n");
+        } else {
+            xSemaphoreTake(ctx_done, portMAX_DELAY);
+            vTaskDelete(trigger);
+            ok = 1;
+        }
+        irq_action = NULL;
+        vTaskDelete(irq_waiter);
+        irq_waiter = NULL;
+    }
+
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    return ok;
+}
+#endif
+
+#if configUSE_TASK_NOTIFICATIONS == 1
+/* Interrupt to task wake latency, the handler gives a binary semaphore or
+ * notifies the waiting task. */
+
+static xSemaphoreHandle notify_sem;
+
+static void notify_sem_give(signed portBASE_TYPE *woken)
+{
+    xSemaphoreGiveFromISR(notify_sem, woken);
+}
+
+static void notify_sem_take(void)
+{
+    xSemaphoreTake(notify_sem, portMAX_DELAY);
+}
+
+static void notify_give(signed portBASE_TYPE *woken)
+{
+    vTaskNotifyGiveFromISR(irq_waiter, woken);
+}
+
+static void notify_take(void)
+{
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+static void bench_notify(int n, char *argv[])
+{
+    if (!ctx_init())
+        return;
+    if (!notify_sem) {
+        vSemaphoreCreateBinary(notify_sem);
+        if (!notify_sem) {
+            fio_printf(2, "bench: out of memory\r\n");
+            return;
+        }
+    }
+
+    xSemaphoreTake(notify_sem, 0);
+    if (!irq_run(notify_sem_give, notify_sem_take))
+        return;
+    fio_printf(1, "%-18s", "binary semaphore");
+    bench_print(&ctx_result);
+
+    if (!irq_run(notify_give, notify_take))
+        return;
+    fio_printf(1, "%-18s", "notification");
+    bench_print(&ctx_result);
+}
+#endif
+
+#if configUSE_STREAM_BUFFERS == 1
+/* Byte throughput.  A task at priority 1 writes STREAM_BYTES in transfers of
+ * 1, 16 or 256 bytes to a task at priority 3 that reads them back in the same
+ * sizes.  The queue moves one byte per call and wakes the reader for each
+ * byte; the stream buffer copies a whole transfer per call and, with its
+ * trigger level set to the transfer size, wakes the reader once per transfer;
+ * the message buffer also stores the length of each transfer. */
+
+enum stream_kind {
+    STREAM_QUEUE,
+    STREAM_BUFFER,
+    STREAM_MESSAGE,
+};
+
+static enum stream_kind stream_kind;
+static size_t stream_chunk;
+static xQueueHandle stream_queue;
+static xStreamBufferHandle stream_buffer;
+static unsigned char stream_source[STREAM_CHUNK_MAX];
+static unsigned char stream_sink[STREAM_CHUNK_MAX];
+
+static void stream_writer_task(void *pvParameters)
+{
+    unsigned long sent;
+    size_t i;
+
+    for (sent = 0; sent < STREAM_BYTES; sent += stream_chunk) {
+        if (stream_kind == STREAM_QUEUE) {
+            for (i = 0; i < stream_chunk; i++)
+                xQueueSend(stream_queue, &stream_source[i], portMAX_DELAY);
+        } else {
+            /* Message buffers take the same calls, see message_buffer.h. */
+            xStreamBufferSend(stream_buffer, stream_source, stream_chunk,
+                              portMAX_DELAY);
+        }
+    }
+    vTaskSuspend(NULL);
+}
+
+static void stream_reader_task(void *pvParameters)
+{
+    unsigned long received = 0;
+    size_t i;
+
+    while (received < STREAM_BYTES) {
+        if (stream_kind == STREAM_QUEUE) {
+            for (i = 0; i < stream_chunk; i++)
+                xQueueReceive(stream_queue, &stream_sink[i], portMAX_DELAY);
+            received += stream_chunk;
+        } else {
+            received += xStreamBufferReceive(stream_buffer, stream_sink,
+                                             stream_chunk, portMAX_DELAY);
+        }
+    }
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+/* Runs one transfer, returns the cycles it took or 0 if out of memory. */
+static unsigned long stream_run(enum stream_kind kind, size_t chunk)
+{
+    xTaskHandle reader, writer;
+    unsigned long start, cycles = 0;
+
+    stream_kind = kind;
+    stream_chunk = chunk;
+    if (kind == STREAM_QUEUE)
+        stream_queue = xQueueCreate(STREAM_CAPACITY, 1);
+    else if (kind == STREAM_BUFFER)
+        stream_buffer = xStreamBufferCreate(STREAM_CAPACITY, chunk);
+    else
+        stream_buffer = xMessageBufferCreate(STREAM_CAPACITY);
+    if (!stream_queue && !stream_buffer)
+        return 0;
+
+    if (xTaskCreate(stream_reader_task, (signed portCHAR *) "strm-rd",
+                    configMINIMAL_STACK_SIZE, NULL, 3, &reader) == pdPASS) {
+        start = clock_cycles();
+        if (xTaskCreate(stream_writer_task, (signed portCHAR *) "strm-wr",
+                        configMINIMAL_STACK_SIZE, NULL, 1, &writer) == pdPASS) {
+            xSemaphoreTake(ctx_done, portMAX_DELAY);
+            cycles = clock_cycles() - start;
+            vTaskDelete(writer);
+        }
+        vTaskDelete(reader);
+    }
+
+    if (stream_queue)
+        vQueueDelete(stream_queue);
+    if (stream_buffer)
+        vStreamBufferDelete(stream_buffer);
+    stream_queue = NULL;
+    stream_buffer = NULL;
+    return cycles;
+}
+
+static void bench_stream(int n, char *argv[])
+{
+    static const size_t chunks[] = { 1, 16, STREAM_CHUNK_MAX };
+    unsigned long cycles;
+    unsigned int i;
+    int kind;
+
+    if (!ctx_init())
+        return;
+
+    fio_printf(1, "%d bytes per run\r\n", STREAM_BYTES);
+    fio_printf(1, "%-8s%15s%15s%15s\r\n", "transfer", "queue", "stream", "message");
+    fio_printf(1, "%-8s%15s%15s%15s\r\n", "", "cyc/B   KB/s", "cyc/B   KB/s",
+               "cyc/B   KB/s");
+    for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        fio_printf(1, "%5u B  ", (unsigned int) chunks[i]);
+        for (kind = STREAM_QUEUE; kind <= STREAM_MESSAGE; kind++) {
+            cycles = stream_run(kind, chunks[i]);
+            if (!cycles) {
+                fio_printf(1, "\r\n");
+                fio_printf(2, "bench: out of memory\r\n");
+                return;
+            }
+            fio_printf(1, " %7lu %6lu", cycles / STREAM_BYTES,
+                       STREAM_BYTES / 1024 * configCPU_CLOCK_HZ / cycles);
+        }
+        fio_printf(1, "\r\n");
+    }
+}
+#endif
+
+#if configUSE_QUEUE_BATCH == 1
+/* Queue throughput vs batch size.  A task at priority 1 posts BATCH_RECORDS
+ * 16 byte records, a batch at a time, to a task at priority 3 that receives
+ * up to a batch at a time.  Each call enters one critical section and wakes
+ * the reader once, so the cost per record falls with the batch size.  The
+ * first line is the same transfer with xQueueSend() and xQueueReceive(). */
+
+struct batch_record {
+    unsigned long time;
+    unsigned long value[3];
+};
+
+static xQueueHandle batch_queue;
+static int batch_size;
+static struct batch_record batch_source[BATCH_MAX];
+static struct batch_record batch_sink[BATCH_MAX];
+
+static void batch_writer_task(void *pvParameters)
+{
+    unsigned long sent = 0;
+
+    while (sent < BATCH_RECORDS) {
+        if (batch_size) {
+            sent += uxQueueSendMultiple(batch_queue, batch_source, batch_size,
+                                        portMAX_DELAY);
+        } else if (xQueueSend(batch_queue, &batch_source[0], portMAX_DELAY)) {
+            sent++;
+        }
+    }
+    vTaskSuspend(NULL);
+}
+
+static void batch_reader_task(void *pvParameters)
+{
+    unsigned long received = 0;
+
+    while (received < BATCH_RECORDS) {
+        if (batch_size) {
+            received += uxQueueReceiveMultiple(batch_queue, batch_sink,
+                                               batch_size, portMAX_DELAY);
+        } else if (xQueueReceive(batch_queue, &batch_sink[0], portMAX_DELAY)) {
+            received++;
+        }
+    }
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+static void bench_batch(int n, char *argv[])
+{
+    /* 0 stands for the single item calls. */
+    static const int sizes[] = { 0, 1, 2, 4, 8, 16, 32, BATCH_MAX };
+    xTaskHandle reader, writer;
+    unsigned long start, cycles;
+    unsigned int i;
+
+    if (!ctx_init())
+        return;
+    batch_queue = xQueueCreate(BATCH_QUEUE_LENGTH, sizeof(struct batch_record));
+    if (!batch_queue) {
+        fio_printf(2, "bench: out of memory\r\n");
+        return;
+    }
+
+    fio_printf(1, "%d records of %d bytes\r\n", BATCH_RECORDS,
+               (int) sizeof(struct batch_record));
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        batch_size = sizes[i];
+        if (xTaskCreate(batch_reader_task, (signed portCHAR *) "batch-rd",
+                        configMINIMAL_STACK_SIZE, NULL, 3, &reader) != pdPASS) {
+            fio_printf(2, "bench: out of memory\r\n");
+            break;
+        }
+        start = clock_cycles();
+        if (xTaskCreate(batch_writer_task, (signed portCHAR *) "batch-wr",
+                        configMINIMAL_STACK_SIZE, NULL, 1, &writer) != pdPASS) {
+            vTaskDelete(reader);
+            fio_printf(2, "bench: out of memory\r\n");
+            break;
+        }
+        xSemaphoreTake(ctx_done, portMAX_DELAY);
+        cycles = clock_cycles() - start;
+        vTaskDelete(writer);
+        vTaskDelete(reader);
+        xQueueReset(batch_queue);
+
+        if (batch_size)
+            fio_printf(1, "batch %2d       ", batch_size);
+        else
+            fio_printf(1, "single item    ");
+        fio_printf(1, "%5lu cycles per record\r\n", cycles / BATCH_RECORDS);
+    }
+
+    vQueueDelete(batch_queue);
+    batch_queue = NULL;
+}
+#endif
+
+#if configUSE_MAILBOXES == 1
+/* Large payloads, copied vs passed by reference.  A task at priority 1 sends
+ * MAILBOX_TRANSFERS payloads to a task at priority 3.  Through a queue each
+ * payload is copied into the queue storage and out again; through a mailbox
+ * the writer borrows a pool buffer, writes it in place and posts the pointer,
+ * and the reader returns the buffer once done.  Both sides stamp and check a
+ * sequence number so neither transfer is optimised into nothing, and the
+ * pool's release callback counts the buffers coming back. */
+
+enum mailbox_kind {
+    MAILBOX_QUEUE,
+    MAILBOX_BY_REFERENCE,
+};
+
+static enum mailbox_kind mailbox_kind;
+static xQueueHandle mailbox_queue;
+static xMailboxPoolHandle mailbox_pool;
+static xMailboxHandle mailbox;
+static unsigned long *mailbox_source;
+static unsigned long *mailbox_sink;
+static unsigned long mailbox_released;
+static int mailbox_errors;
+
+static void mailbox_release(void *buffer)
+{
+    mailbox_released++;
+}
+
+static void mailbox_writer_task(void *pvParameters)
+{
+    unsigned long seq, *payload;
+
+    for (seq = 0; seq < MAILBOX_TRANSFERS; seq++) {
+        if (mailbox_kind == MAILBOX_QUEUE) {
+            mailbox_source[0] = seq;
+            xQueueSend(mailbox_queue, mailbox_source, portMAX_DELAY);
+        } else {
+            payload = pvMailboxBorrow(mailbox_pool, portMAX_DELAY);
+            payload[0] = seq;
+            xMailboxPost(mailbox, payload, portMAX_DELAY);
+        }
+    }
+    vTaskSuspend(NULL);
+}
+
+static void mailbox_reader_task(void *pvParameters)
+{
+    unsigned long seq, *payload;
+
+    for (seq = 0; seq < MAILBOX_TRANSFERS; seq++) {
+        if (mailbox_kind == MAILBOX_QUEUE) {
+            xQueueReceive(mailbox_queue, mailbox_sink, portMAX_DELAY);
+            if (mailbox_sink[0] != seq)
+                mailbox_errors++;
+        } else {
+            payload = pvMailboxFetch(mailbox, portMAX_DELAY);
+            if (payload[0] != seq)
+                mailbox_errors++;
+            vMailboxReturn(payload);
+        }
+    }
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+/* Runs one transfer, returns the cycles it took or 0 if out of memory. */
+static unsigned long mailbox_run(enum mailbox_kind kind, size_t payload)
+{
+    xTaskHandle reader, writer;
+    unsigned long start, cycles = 0;
+
+    mailbox_kind = kind;
+    if (kind == MAILBOX_QUEUE) {
+        mailbox_queue = xQueueCreate(MAILBOX_DEPTH, payload);
+        mailbox_source = pvPortMalloc(payload);
+        mailbox_sink = pvPortMalloc(payload);
+        if (!mailbox_queue || !mailbox_source || !mailbox_sink)
+            goto out;
+    } else {
+        mailbox_pool = xMailboxPoolCreate(MAILBOX_DEPTH, payload,
+                                          mailbox_release);
+        mailbox = xMailboxCreate(MAILBOX_DEPTH);
+        if (!mailbox_pool || !mailbox)
+            goto out;
+    }
+
+    if (xTaskCreate(mailbox_reader_task, (signed portCHAR *) "mbox-rd",
+                    configMINIMAL_STACK_SIZE, NULL, 3, &reader) == pdPASS) {
+        start = clock_cycles();
+        if (xTaskCreate(mailbox_writer_task, (signed portCHAR *) "mbox-wr",
+                        configMINIMAL_STACK_SIZE, NULL, 1, &writer) == pdPASS) {
+            xSemaphoreTake(ctx_done, portMAX_DELAY);
+            cycles = clock_cycles() - start;
+            vTaskDelete(writer);
+        }
+        vTaskDelete(reader);
+    }
+
+out:
+    if (mailbox_queue)
+        vQueueDelete(mailbox_queue);
+    vPortFree(mailbox_source);
+    vPortFree(mailbox_sink);
+    if (mailbox)
+        vMailboxDelete(mailbox);
+    if (mailbox_pool)
+        vMailboxPoolDelete(mailbox_pool);
+    mailbox_queue = NULL;
+    mailbox_source = mailbox_sink = NULL;
+    mailbox = NULL;
+    mailbox_pool = NULL;
+    return cycles;
+}
+
+static void bench_mailbox(int n, char *argv[])
+{
+    static const size_t payloads[] = { 256, 1024 };
+    unsigned long cycles;
+    unsigned int i;
+    int kind;
+
+    if (!ctx_init())
+        return;
+
+    mailbox_errors = 0;
+    mailbox_released = 0;
+    fio_printf(1, "%d transfers per run, cycles per transfer\r\n",
+               MAILBOX_TRANSFERS);
+    fio_printf(1, "%-8s%10s%10s\r\n", "payload", "queue", "mailbox");
+    for (i = 0; i < sizeof(payloads) / sizeof(payloads[0]); i++) {
+        fio_printf(1, "%5u B ", (unsigned int) payloads[i]);
+        for (kind = MAILBOX_QUEUE; kind <= MAILBOX_BY_REFERENCE; kind++) {
+            cycles = mailbox_run(kind, payloads[i]);
+            if (!cycles) {
+                fio_printf(1, "\r\n");
+                fio_printf(2, "bench: out of memory\r\n");
+                return;
+            }
+            fio_printf(1, " %9lu", cycles / MAILBOX_TRANSFERS);
+        }
+        fio_printf(1, "\r\n");
+    }
+
+    if (mailbox_errors)
+        fio_printf(2, "bench: %d payloads out of sequence\r\n", mailbox_errors);
+    if (mailbox_released != MAILBOX_TRANSFERS * i)
+        fio_printf(2, "bench: %lu of %lu buffers released\r\n",
+                   mailbox_released, (unsigned long) MAILBOX_TRANSFERS * i);
+}
+#endif
+
+#if configUSE_EVENT_GROUPS == 1
+/* Broadcast wake up.  Waiters at priority 3 are added in steps, and each
+ * round the shell task wakes all of them, either by giving every waiter its
+ * own semaphore or with one xEventGroupSetBits() that releases every waiter
+ * in a single pass over the event list.  A round is timed from before the
+ * first call until every waiter has run and blocked again.  Both sets of
+ * waiters stay blocked side by side, only the one being signalled runs. */
+
+#define EVENTS_BIT 0x01
+
+static xEventGroupHandle events_group;
+static xSemaphoreHandle events_sems[EVENTS_WAITERS_MAX];
+static xTaskHandle events_sem_waiters[EVENTS_WAITERS_MAX];
+static xTaskHandle events_group_waiters[EVENTS_WAITERS_MAX];
+static volatile unsigned long events_woken;
+
+static void events_sem_task(void *pvParameters)
+{
+    xSemaphoreHandle sem = pvParameters;
+
+    for (;;) {
+        xSemaphoreTake(sem, portMAX_DELAY);
+        events_woken++;
+    }
+}
+
+static void events_group_task(void *pvParameters)
+{
+    for (;;) {
+        xEventGroupWaitBits(events_group, EVENTS_BIT, pdTRUE, pdFALSE,
+                            portMAX_DELAY);
+        events_woken++;
+    }
+}
+
+static void bench_events(int n, char *argv[])
+{
+    static const int steps[] = { 1, 2, 4, EVENTS_WAITERS_MAX };
+    struct bench_result sem_result, group_result;
+    unsigned long start, expected = 0;
+    unsigned int i, round;
+    int waiters = 0, w;
+
+    if (!events_group)
+        events_group = xEventGroupCreate();
+    for (w = 0; w < EVENTS_WAITERS_MAX; w++) {
+        if (!events_sems[w]) {
+            vSemaphoreCreateBinary(events_sems[w]);
+            if (events_sems[w])
+                xSemaphoreTake(events_sems[w], 0);
+        }
+    }
+    if (!events_group || !events_sems[EVENTS_WAITERS_MAX - 1]) {
+        fio_printf(2, "bench: out of memory\r\n");
+        return;
+    }
+
+    events_woken = 0;
+    fio_printf(1, "%d rounds per step, cycles per round\r\n", EVENTS_ROUNDS);
+    for (i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        /* Waiters run above the shell so each blocks as soon as it is
+         * created. */
+        for (; waiters < steps[i]; waiters++) {
+            if (xTaskCreate(events_sem_task, (signed portCHAR *) "ev-sem",
+                            EVENTS_WAITER_STACK, events_sems[waiters], 3,
+                            &events_sem_waiters[waiters]) != pdPASS)
+                break;
+            if (xTaskCreate(events_group_task, (signed portCHAR *) "ev-grp",
+                            EVENTS_WAITER_STACK, NULL, 3,
+                            &events_group_waiters[waiters]) != pdPASS) {
+                vTaskDelete(events_sem_waiters[waiters]);
+                break;
+            }
+        }
+        if (waiters < steps[i]) {
+            fio_printf(2, "bench: out of memory at %d waiters\r\n", waiters);
+            break;
+        }
+
+        bench_reset(&sem_result);
+        bench_reset(&group_result);
+        for (round = 0; round < EVENTS_ROUNDS; round++) {
+            start = clock_cycles();
+            for (w = 0; w < waiters; w++)
+                xSemaphoreGive(events_sems[w]);
+            bench_record(&sem_result, clock_cycles() - start);
+
+            start = clock_cycles();
+            xEventGroupSetBits(events_group, EVENTS_BIT);
+            bench_record(&group_result, clock_cycles() - start);
+        }
+        expected += 2UL * waiters * EVENTS_ROUNDS;
+
+        fio_printf(1, "%d waiters, semaphores   ", waiters);
+        bench_print(&sem_result);
+        fio_printf(1, "%d waiters, event group  ", waiters);
+        bench_print(&group_result);
+    }
+
+    while (waiters > 0) {
+        waiters--;
+        vTaskDelete(events_sem_waiters[waiters]);
+        vTaskDelete(events_group_waiters[waiters]);
+    }
+
+    if (events_woken != expected)
+        fio_printf(2, "bench: %lu of %lu wake ups\r\n", events_woken, expected);
+}
+#endif
+
+#if configUSE_HRTIMER == 1
+/* High resolution timer jitter.  A periodic timer runs for HRTIMER_EXPIRIES
+ * expiries, first on an idle system, then with a task at priority 1 that
+ * keeps interrupts masked in short critical sections, as drivers and the
+ * kernel do.  Latencies are microseconds from each deadline to the TIM2
+ * interrupt and to the callback in the daemon task. */
+
+static xSemaphoreHandle hrtimer_done;
+static volatile unsigned long hrtimer_expired;
+
+static void hrtimer_tick(struct hrtimer *timer, void *arg)
+{
+    if (++hrtimer_expired == HRTIMER_EXPIRIES) {
+        hrtimer_cancel(timer);
+        xSemaphoreGive(hrtimer_done);
+    }
+}
+
+static void hrtimer_load_task(void *pvParameters)
+{
+    volatile int i;
+
+    for (;;) {
+        taskENTER_CRITICAL();
+        for (i = 0; i < HRTIMER_LOAD_SPIN; i++);
+        taskEXIT_CRITICAL();
+    }
+}
+
+static void hrtimer_print(const char *label, const struct hrtimer_latency *l)
+{
+    fio_printf(1, "  %-9s ", label);
+    if (l->count == 0) {
+        fio_printf(1, "no samples\r\n");
+        return;
+    }
+    fio_printf(1, "min %4lu  avg %4lu  max %5lu us\r\n",
+               l->min, l->total / l->count, l->max);
+}
+
+static void bench_hrtimer(int n, char *argv[])
+{
+    static struct hrtimer timer;
+    struct hrtimer_latency isr, callback;
+    unsigned long period = n > 1 ? (unsigned long) atoi(argv[1]) : HRTIMER_PERIOD;
+    portTickType timeout;
+    xTaskHandle load = NULL;
+    int loaded;
+
+    if (period == 0)
+        period = HRTIMER_PERIOD;
+    if (!hrtimer_done)
+        vSemaphoreCreateBinary(hrtimer_done);
+    xSemaphoreTake(hrtimer_done, 0);
+    timeout = HRTIMER_EXPIRIES * period / 1000 / portTICK_RATE_MS + 100;
+
+    fio_printf(1, "%d expiries every %lu us\r\n", HRTIMER_EXPIRIES, period);
+    for (loaded = 0; loaded < 2; loaded++) {
+        if (loaded && xTaskCreate(hrtimer_load_task, (signed char *) "load",
+                                  HRTIMER_LOAD_STACK, NULL,
+                                  tskIDLE_PRIORITY + 1, &load) != pdPASS) {
+            fio_printf(2, "bench: cannot create the load task\r\n");
+            return;
+        }
+
+        hrtimer_expired = 0;
+        hrtimer_stats(NULL, NULL, 1);
+        timer.overruns = 0;
+        hrtimer_start(&timer, period, period, hrtimer_tick, NULL);
+        if (!xSemaphoreTake(hrtimer_done, timeout)) {
+            hrtimer_cancel(&timer);
+            fio_printf(2, "bench: %lu of %d expiries\r\n",
+                       hrtimer_expired, HRTIMER_EXPIRIES);
+        }
+        hrtimer_stats(&isr, &callback, 0);
+
+        if (load)
+            vTaskDelete(load);
+        fio_printf(1, "%s, %lu overruns\r\n", loaded ? "loaded" : "idle",
+                   timer.overruns);
+        hrtimer_print("interrupt", &isr);
+        hrtimer_print("callback", &callback);
+    }
+}
+#endif
+
+#if configUSE_FAST_MUTEXES == 1
+/* Mutex take and give, kernel mutex vs fast mutex.  Uncontended, the shell
+ * task takes and gives the mutex nobody else uses and each pair is timed.
+ * Contended, a task at priority 1 takes the mutex and wakes one at priority
+ * 3, which then times its own take: it blocks, lends its priority to the
+ * holder, which gives the mutex back and so hands it over.  That is the
+ * fast mutex's kernel fallback, two switches and the inheritance included. */
+
+static xSemaphoreHandle mutex_kernel;
+static xFastMutex mutex_fast;
+static volatile int mutex_use_fast;
+
+static void mutex_take(void)
+{
+    if (mutex_use_fast)
+        xFastMutexTake(&mutex_fast, portMAX_DELAY);
+    else
+        xSemaphoreTake(mutex_kernel, portMAX_DELAY);
+}
+
+static void mutex_give(void)
+{
+    if (mutex_use_fast)
+        xFastMutexGive(&mutex_fast);
+    else
+        xSemaphoreGive(mutex_kernel);
+}
+
+static void mutex_holder_task(void *pvParameters)
+{
+    for (;;) {
+        mutex_take();
+        xSemaphoreGive(ctx_wake);
+        mutex_give();
+    }
+}
+
+static void mutex_waiter_task(void *pvParameters)
+{
+    unsigned long start;
+    int i;
+
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        xSemaphoreTake(ctx_wake, portMAX_DELAY);
+        start = clock_cycles();
+        mutex_take();
+        bench_record(&ctx_result, clock_cycles() - start);
+        mutex_give();
+    }
+
+    /* The holder has just given the mutex and is preempted by the shell
+     * before it takes it again, so it is deleted without it. */
+    xSemaphoreGive(ctx_done);
+    vTaskSuspend(NULL);
+}
+
+static void bench_mutex(int n, char *argv[])
+{
+    xTaskHandle holder, waiter;
+    unsigned long start;
+    int i;
+
+    if (!ctx_init())
+        return;
+    if (!mutex_kernel) {
+        mutex_kernel = xSemaphoreCreateMutex();
+        if (!mutex_kernel) {
+            fio_printf(2, "bench: out of memory\r\n");
+            return;
+        }
+        vFastMutexInitialise(&mutex_fast);
+    }
+
+    bench_reset(&ctx_result);
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        start = clock_cycles();
+        xSemaphoreTake(mutex_kernel, portMAX_DELAY);
+        xSemaphoreGive(mutex_kernel);
+        bench_record(&ctx_result, clock_cycles() - start);
+    }
+    fio_printf(1, "uncontended, kernel  ");
+    bench_print(&ctx_result);
+
+    bench_reset(&ctx_result);
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        start = clock_cycles();
+        xFastMutexTake(&mutex_fast, portMAX_DELAY);
+        xFastMutexGive(&mutex_fast);
+        bench_record(&ctx_result, clock_cycles() - start);
+    }
+    fio_printf(1, "uncontended, fast    ");
+    bench_print(&ctx_result);
+
+    for (mutex_use_fast = 0; mutex_use_fast < 2; mutex_use_fast++) {
+        bench_reset(&ctx_result);
+        xSemaphoreTake(ctx_wake, 0);
+        mutex_fast.ulContentions = 0;
+
+        if (xTaskCreate(mutex_waiter_task, (signed portCHAR *) "mtx-hi",
+                        MUTEX_TASK_STACK, NULL, 3, &waiter) != pdPASS) {
+            fio_printf(2, "bench: out of memory\r\n");
+            return;
+        }
+        if (xTaskCreate(mutex_holder_task, (signed portCHAR *) "mtx-lo",
+                        MUTEX_TASK_STACK, NULL, 1, &holder) != pdPASS) {
+            vTaskDelete(waiter);
+            fio_printf(2, "bench: out of memory\r\n");
+            return;
+        }
+
+        xSemaphoreTake(ctx_done, portMAX_DELAY);
+        vTaskDelete(waiter);
+        vTaskDelete(holder);
+
+        fio_printf(1, "contended, %s   ", mutex_use_fast ? "fast  " : "kernel");
+        bench_print(&ctx_result);
+    }
+    fio_printf(1, "fast mutex contentions: %lu\r\n", mutex_fast.ulContentions);
+}
+#endif
+
+#if configUSE_EDF_SCHEDULING == 1
+/* Schedulable utilization, EDF vs rate monotonic.  Two periodic tasks with
+ * periods of 5 and 7 ticks, deadlines equal to their periods, share a total
+ * utilization U equally and spin for their share of every period.  At each U
+ * the set runs once in the EDF class, both at configEDF_PRIORITY, and once
+ * with rate monotonic fixed priorities, the 5 tick task alone at
+ * configEDF_PRIORITY and the 7 tick task one below.  Each task counts its
+ * jobs and the ones completed after their deadline.  Rate monotonic misses
+ * from about 85% on, EDF only when the kernel and the tick no longer fit in
+ * what is left. */
+
+struct edf_task {
+    portTickType period;
+    unsigned long cycles;       /* spun per job */
+    portTickType release;       /* of the current job */
+    unsigned long jobs;
+    unsigned long misses;
+};
+
+static struct edf_task edf_tasks[2] = { { 5 }, { 7 } };
+static volatile int edf_finished;
+
+/* Spins until the calling task has run for the given cycles itself, gaps
+ * where another task ran are not counted. */
+static void edf_spin(unsigned long cycles)
+{
+    unsigned long last = clock_cycles(), now, done = 0;
+
+    while (done < cycles) {
+        now = clock_cycles();
+        if (now - last < EDF_PREEMPT_GAP)
+            done += now - last;
+        last = now;
+    }
+}
+
+static void edf_task(void *pvParameters)
+{
+    struct edf_task *t = pvParameters;
+    unsigned long jobs = EDF_RUN_TICKS / t->period;
+
+    for (t->jobs = 0; t->jobs < jobs; t->jobs++) {
+        edf_spin(t->cycles);
+        if (xTaskGetTickCount() - t->release > t->period)
+            t->misses++;
+        t->release += t->period;
+        vTaskWaitForNextPeriod();
+    }
+
+    taskENTER_CRITICAL();
+    if (++edf_finished == 2)
+        xSemaphoreGive(ctx_done);
+    taskEXIT_CRITICAL();
+    vTaskSuspend(NULL);
+}
+
+static void bench_edf(int n, char *argv[])
+{
+    static const int percents[] = { 50, 60, 70, 80, 85, 90, 95, 100 };
+    const unsigned long tick_cycles = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    xTaskHandle tasks[2];
+    unsigned int i;
+    int edf, t;
+
+    if (!ctx_init())
+        return;
+
+    fio_printf(1, "periods %u and %u ticks, %d ticks per run\r\n",
+               (unsigned int) edf_tasks[0].period,
+               (unsigned int) edf_tasks[1].period, EDF_RUN_TICKS);
+    fio_printf(1, "   U     EDF jobs missed     RM jobs missed\r\n");
+    for (i = 0; i < sizeof(percents) / sizeof(percents[0]); i++) {
+        fio_printf(1, "%3d%%", percents[i]);
+        for (edf = 1; edf >= 0; edf--) {
+            for (t = 0; t < 2; t++) {
+                edf_tasks[t].cycles = tick_cycles * edf_tasks[t].period / 100
+                                      * percents[i] / 2;
+                edf_tasks[t].jobs = 0;
+                edf_tasks[t].misses = 0;
+            }
+            edf_finished = 0;
+
+            /* Both released in the same tick, the tick count stands still
+             * while the scheduler is suspended. */
+            vTaskSuspendAll();
+            for (t = 0; t < 2; t++) {
+                if (xTaskCreate(edf_task, (signed portCHAR *) "edf",
+                                EDF_TASK_STACK, &edf_tasks[t],
+                                edf || t == 0 ? configEDF_PRIORITY
+                                              : configEDF_PRIORITY - 1,
+                                &tasks[t]) != pdPASS)
+                    break;
+                if (xTaskSetPeriodic(tasks[t], edf_tasks[t].period,
+                                     edf_tasks[t].period) != pdPASS) {
+                    vTaskDelete(tasks[t]);
+                    break;
+                }
+                edf_tasks[t].release = xTaskGetTickCount();
+            }
+            if (t < 2) {
+                while (t > 0)
+                    vTaskDelete(tasks[--t]);
+                xTaskResumeAll();
+                fio_printf(2, "\r\nbench: out of memory\r\n");
+                return;
+            }
+            xTaskResumeAll();
+
+            xSemaphoreTake(ctx_done, portMAX_DELAY);
+            for (t = 0; t < 2; t++)
+                vTaskDelete(tasks[t]);
+
+            fio_printf(1, "     %9lu %6lu", edf_tasks[0].jobs + edf_tasks[1].jobs,
+                       edf_tasks[0].misses + edf_tasks[1].misses);
+        }
+        fio_printf(1, "\r\n");
+    }
+}
+#endif
+
+#if configUSE_DEFERRED_CALLS == 1 && configUSE_STREAM_BUFFERS == 1
+/* Interrupt work done in the handler vs deferred to the daemon.  The
+ * interrupt stands for a byte received and the waiting task reads it from a
+ * stream buffer, as the shell does on the USART.  The handler either sends
+ * the byte to the stream buffer itself or pends defer_rx_byte() for the
+ * daemon to send it.  Also recorded are the time spent in the handler and
+ * the time from pending the interrupt to the deferred function starting. */
+
+static xStreamBufferHandle defer_stream;
+static struct bench_result defer_isr;
+static struct bench_result defer_function;
+
+static void defer_rx_byte(void *unused, unsigned long byte)
+{
+    char c = byte;
+
+    bench_record(&defer_function, clock_cycles() - irq_start);
+    xStreamBufferSend(defer_stream, &c, 1, 0);
+}
+
+static void defer_send(signed portBASE_TYPE *woken)
+{
+    unsigned long start = clock_cycles();
+    char c = 'x';
+
+    xStreamBufferSendFromISR(defer_stream, &c, 1, woken);
+    bench_record(&defer_isr, clock_cycles() - start);
+}
+
+static void defer_pend(signed portBASE_TYPE *woken)
+{
+    unsigned long start = clock_cycles();
+
+    xPendFunctionCallFromISR(defer_rx_byte, NULL, 'x', woken);
+    bench_record(&defer_isr, clock_cycles() - start);
+}
+
+static void defer_receive(void)
+{
+    char c;
+
+    xStreamBufferReceive(defer_stream, &c, 1, portMAX_DELAY);
+}
+
+static void bench_deferred(int n, char *argv[])
+{
+    xDeferredStats stats;
+    int in_isr;
+
+    if (!ctx_init())
+        return;
+    if (!defer_stream) {
+        defer_stream = xStreamBufferCreate(DEFER_STREAM_BYTES, 1);
+        if (!defer_stream) {
+            fio_printf(2, "bench: out of memory\r\n");
+            return;
+        }
+    }
+
+    for (in_isr = 1; in_isr >= 0; in_isr--) {
+        bench_reset(&defer_isr);
+        bench_reset(&defer_function);
+        vDeferredGetStats(&stats, pdTRUE);
+
+        if (!irq_run(in_isr ? defer_send : defer_pend, defer_receive))
+            return;
+        vDeferredGetStats(&stats, pdFALSE);
+
+        fio_printf(1, "%s\r\n", in_isr ? "in the handler" : "deferred");
+        fio_printf(1, "  %-9s ", "handler");
+        bench_print(&defer_isr);
+        if (!in_isr) {
+            fio_printf(1, "  %-9s ", "function");
+            bench_print(&defer_function);
+        }
+        fio_printf(1, "  %-9s ", "task");
+        bench_print(&ctx_result);
+        if (!in_isr)
+            fio_printf(1, "  %lu calls, at most %u waiting, %lu overflows\r\n",
+                       stats.ulCalls, (unsigned int) stats.uxHighWaterMark,
+                       stats.ulOverflows);
+    }
+}
+#endif
+
+static const struct bench benches[] = {
+    { "ctx", bench_ctx, "context switch round trip vs priority gap" },
+    { "delay", bench_delay, "blocking with a timeout vs blocked tasks" },
+#if configUSE_TASK_NOTIFICATIONS == 1
+    { "notify", bench_notify, "interrupt to task wake, semaphore vs notification" },
+#endif
+#if configUSE_QUEUE_BATCH == 1
+    { "batch", bench_batch, "queue throughput vs batch size" },
+#endif
+#if configUSE_STREAM_BUFFERS == 1
+    { "stream", bench_stream, "byte throughput, queue vs stream and message buffers" },
+#endif
+#if configUSE_MAILBOXES == 1
+    { "mailbox", bench_mailbox, "large payloads, queue copy vs mailbox by reference" },
+#endif
+#if configUSE_EVENT_GROUPS == 1
+    { "events", bench_events, "waking n tasks, n semaphores vs one event group" },
+#endif
+#if configUSE_HRTIMER == 1
+    { "hrtimer", bench_hrtimer, "TIM2 timer latency, idle and under load" },
+#endif
+#if configUSE_FAST_MUTEXES == 1
+    { "mutex", bench_mutex, "take and give, kernel mutex vs fast mutex" },
+#endif
+#if configUSE_EDF_SCHEDULING == 1
+    { "edf", bench_edf, "periodic task set misses vs utilization, EDF vs RM" },
+#endif
+#if configUSE_DEFERRED_CALLS == 1 && configUSE_STREAM_BUFFERS == 1
+    { "deferred", bench_deferred, "interrupt work in the handler vs deferred to the daemon" },
+#endif
+};
+
+void bench_command(int n, char *argv[])
+{
+    unsigned int i;
+
+    for (i = 0; n > 1 && i < sizeof(benches) / sizeof(benches[0]); i++) {
+        if (!strcmp(argv[1], benches[i].name)) {
+            benches[i].run(n - 1, argv + 1);
+            return;
+        }
+    }
+
+    fio_printf(1, "Usage: bench <name>\r\n");
+    for (i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+        fio_printf(1, "  %-8s %s\r\n", benches[i].name, benches[i].desc);
+}
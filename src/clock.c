@@ -0,0 +1,81 @@
+#include "FreeRTOS.h"
+
+#define SYST_LOAD  (*(volatile unsigned long *) 0xe000e014)
+#define SYST_VAL   (*(volatile unsigned long *) 0xe000e018)
+#define SCB_ICSR   (*(volatile unsigned long *) 0xe000ed04)
+#define ICSR_PENDSTSET (1UL << 26)
+
+/* Counts in a normal tick period.  Tickless idle stretches the SysTick period
+ * while it sleeps, so LOAD cannot be used to scale clock_ticks. */
+#define CLOCK_TICK_CYCLES (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+#define CLOCK_TICK_US (1000000UL / configTICK_RATE_HZ)
+#define CLOCK_CYCLES_PER_US (configCPU_CLOCK_HZ / 1000000UL)
+
+static volatile unsigned long clock_ticks;
+
+static inline unsigned long clock_irq_save(void)
+{
+    unsigned long primask;
+
+    __asm volatile ("mrs %0, primask\n"
+                    "cpsid i\n" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void clock_irq_restore(unsigned long primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/* Ticks counted and SysTick counts into the current tick.  A pending SysTick
+ * means the counter reloaded after clock_ticks was last bumped, so account
+ * for that tick by hand. */
+static unsigned long clock_read(unsigned long *cycles)
+{
+    unsigned long primask = clock_irq_save();
+    unsigned long load = SYST_LOAD;
+    unsigned long ticks = clock_ticks;
+    unsigned long val = SYST_VAL;
+
+    if (SCB_ICSR & ICSR_PENDSTSET) {
+        ticks++;
+        val = SYST_VAL;
+    }
+    clock_irq_restore(primask);
+
+    *cycles = load - val;
+    return ticks;
+}
+
+unsigned long clock_cycles(void)
+{
+    unsigned long cycles, ticks = clock_read(&cycles);
+
+    return ticks * CLOCK_TICK_CYCLES + cycles;
+}
+
+unsigned long clock_now_us(void)
+{
+    unsigned long cycles, ticks = clock_read(&cycles);
+
+    return ticks * CLOCK_TICK_US + cycles / CLOCK_CYCLES_PER_US;
+}
+
+unsigned long clock_now_s(unsigned long *us)
+{
+    unsigned long cycles, ticks = clock_read(&cycles);
+
+    *us = ticks % configTICK_RATE_HZ * CLOCK_TICK_US + cycles / CLOCK_CYCLES_PER_US;
+    return ticks / configTICK_RATE_HZ;
+}
+
+void clock_tick(void)
+{
+    clock_ticks++;
+}
+
+/* Tick periods slept through by tickless idle, with interrupts disabled. */
+void clock_step_ticks(unsigned long ticks)
+{
+    clock_ticks += ticks;
+}
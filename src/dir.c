@@ -1,15 +1,15 @@
 #include <FreeRTOS.h>
-#include <semphr.h>
+#include <fast_mutex.h>
 #include "dir.h"
 #include "string.h"
 #include "hash-djb2.h"
 
 static dirdef_t dirds[MAX_DIRS];
-static xSemaphoreHandle dir_sem = NULL;
+static xFastMutex dir_sem;
 
 __attribute__((constructor)) void dir_init() {
     memset(dirds, 0, sizeof(dirds));
-    dir_sem = xSemaphoreCreateMutex();
+    vFastMutexInitialise(&dir_sem);
 }
 
 static dirdef_t * dir_getdird(int dird){
@@ -29,30 +29,30 @@ static int dir_is_open_int(int dird){
 static int dir_finddird(){
     int i;
     for(i = 0; i < MAX_DIRS; ++i){
-        if(!dir_is_open(i))return i;
+        if(!dir_is_open_int(i))return i;
     }
     return -1;
 }
 
 int dir_is_open(int dird){
     int r;
-    xSemaphoreTake(dir_sem, portMAX_DELAY); 
+    xFastMutexTake(&dir_sem, portMAX_DELAY); 
     r = dir_is_open_int(dird);
-    xSemaphoreGive(dir_sem);
+    xFastMutexGive(&dir_sem);
     return r;
 }
 
 int dir_open(dirnext_t dirnext, dirclose_t dirclose, void * opaque){
     int dird;
 
-    xSemaphoreTake(dir_sem, portMAX_DELAY); 
+    xFastMutexTake(&dir_sem, portMAX_DELAY); 
     dird = dir_finddird();
     if(dird > 0){
         dirds[dird].dirnext = dirnext;
         dirds[dird].dirclose = dirclose;
         dirds[dird].opaque = opaque;
     }
-    xSemaphoreGive(dir_sem);
+    xFastMutexGive(&dir_sem);
 
     return dird;
 }
@@ -75,9 +75,9 @@ int dir_close(int dird){
         if(dirds[dird].dirclose){
             r = dirds[dird].dirclose(dirds[dird].opaque); 
         }
-        xSemaphoreTake(dir_sem, portMAX_DELAY); 
+        xFastMutexTake(&dir_sem, portMAX_DELAY); 
         memset(dirds + dird,0,sizeof(dirdef_t));
-        xSemaphoreGive(dir_sem);
+        xFastMutexGive(&dir_sem);
         return r;
     }else{
         return ENOTOPEN;
@@ -1,6 +1,7 @@
 #include "osdebug.h"
 #include "filesystem.h"
 #include "fio.h"
+#include "profile.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -41,7 +42,7 @@ int register_fs(const char * mountpoint, fs_open_t callback, fs_open_dir_t dir_c
 int fs_open(const char * path, int flags, int mode) {
     const char * slash;
     uint32_t hash;
-    int i;
+    int i, fd;
 //    DBGOUT("fs_open(\"%s\", %i, %i)\r\n", path, flags, mode);
     
     while (path[0] == '/')
@@ -52,14 +53,19 @@ int fs_open(const char * path, int flags, int mode) {
     if (!slash)
         return -2;
 
+    PROFILE_BEGIN(fs_open);
     hash = hash_djb2((const uint8_t *) path, slash - path);
     path = slash + 1;
 
     for (i = 0; i < MAX_FS; i++) {
-        if (fss[i].hash == hash)
-            return fss[i].cb(fss[i].opaque, path, flags, mode);
+        if (fss[i].hash == hash) {
+            fd = fss[i].cb(fss[i].opaque, path, flags, mode);
+            PROFILE_END(fs_open);
+            return fd;
+        }
     }
     
+    PROFILE_END(fs_open);
     return -2;
 }
 
@@ -1,6 +1,8 @@
 #include <string.h>
 #include <FreeRTOS.h>
+#include <task.h>
 #include <semphr.h>
+#include <fast_mutex.h>
 #include <unistd.h>
 #include "fio.h"
 #include "dir.h"
@@ -10,8 +12,9 @@
 
 static struct fddef_t fio_fds[MAX_FDS];
 
-/* recv_byte is define in main.c */
+/* recv_byte and recv_byte_poll are define in main.c */
 char recv_byte();
+int recv_byte_poll(xSemaphoreHandle *event);
 void send_byte(char);
 
 enum KeyName{ESC=27, BACKSPACE=127};
@@ -28,6 +31,10 @@ static ssize_t stdin_read(void * opaque, void * buf, size_t count) {
     return i;
 }
 
+static int stdin_poll(void * opaque, xSemaphoreHandle * event) {
+    return recv_byte_poll(event);
+}
+
 static ssize_t stdout_write(void * opaque, const void * buf, size_t count) {
     int i;
     const char * data = (const char *) buf;
@@ -38,14 +45,15 @@ static ssize_t stdout_write(void * opaque, const void * buf, size_t count) {
     return count;
 }
 
-static xSemaphoreHandle fio_sem = NULL;
+static xFastMutex fio_sem;
 
 __attribute__((constructor)) void fio_init() {
     memset(fio_fds, 0, sizeof(fio_fds));
     fio_fds[0].fdread = stdin_read;
+    fio_fds[0].fdpoll = stdin_poll;
     fio_fds[1].fdwrite = stdout_write;
     fio_fds[2].fdwrite = stdout_write;
-    fio_sem = xSemaphoreCreateMutex();
+    vFastMutexInitialise(&fio_sem);
 }
 
 struct fddef_t * fio_getfd(int fd) {
@@ -61,6 +69,7 @@ static int fio_is_open_int(int fd) {
               (fio_fds[fd].fdwrite == NULL) &&
               (fio_fds[fd].fdseek == NULL) &&
               (fio_fds[fd].fdclose == NULL) &&
+              (fio_fds[fd].fdpoll == NULL) &&
               (fio_fds[fd].opaque == NULL));
     return r;
 }
@@ -78,16 +87,16 @@ static int fio_findfd() {
 
 int fio_is_open(int fd) {
     int r = 0;
-    xSemaphoreTake(fio_sem, portMAX_DELAY);
+    xFastMutexTake(&fio_sem, portMAX_DELAY);
     r = fio_is_open_int(fd);
-    xSemaphoreGive(fio_sem);
+    xFastMutexGive(&fio_sem);
     return r;
 }
 
 int fio_open(fdread_t fdread, fdwrite_t fdwrite, fdseek_t fdseek, fdclose_t fdclose, void * opaque) {
     int fd;
 //    DBGOUT("fio_open(%p, %p, %p, %p, %p)\r\n", fdread, fdwrite, fdseek, fdclose, opaque);
-    xSemaphoreTake(fio_sem, portMAX_DELAY);
+    xFastMutexTake(&fio_sem, portMAX_DELAY);
     fd = fio_findfd();
     
     if (fd >= 0) {
@@ -97,7 +106,7 @@ int fio_open(fdread_t fdread, fdwrite_t fdwrite, fdseek_t fdseek, fdclose_t fdcl
         fio_fds[fd].fdclose = fdclose;
         fio_fds[fd].opaque = opaque;
     }
-    xSemaphoreGive(fio_sem);
+    xFastMutexGive(&fio_sem);
     
     return fd;
 }
@@ -153,9 +162,9 @@ int fio_close(int fd) {
     if (fio_is_open_int(fd)) {
         if (fio_fds[fd].fdclose)
             r = fio_fds[fd].fdclose(fio_fds[fd].opaque);
-        xSemaphoreTake(fio_sem, portMAX_DELAY);
+        xFastMutexTake(&fio_sem, portMAX_DELAY);
         memset(fio_fds + fd, 0, sizeof(struct fddef_t));
-        xSemaphoreGive(fio_sem);
+        xFastMutexGive(&fio_sem);
     } else {
         r = -2;
     }
@@ -167,18 +176,125 @@ void fio_set_opaque(int fd, void * opaque) {
         fio_fds[fd].opaque = opaque;
 }
 
+void fio_set_poll(int fd, fdpoll_t fdpoll) {
+    if (fio_is_open_int(fd))
+        fio_fds[fd].fdpoll = fdpoll;
+}
+
+/* Queue sets of FIO_POLL_MAX events, created on first use and kept.  A task
+ * in fio_poll() holds one for as long as it waits. */
+static xQueueSetHandle fio_poll_sets[FIO_POLL_TASKS];
+static unsigned char fio_poll_busy[FIO_POLL_TASKS];
+
+/* Blocks until one of the events is given or the ticks run out, with the
+ * events in a queue set for the time being.  Returns -1 if out of memory,
+ * if more than FIO_POLL_TASKS tasks poll at once or if an event is already
+ * being waited on by another task. */
+static int fio_poll_wait(xSemaphoreHandle * events, int n, portTickType ticks) {
+    xQueueSetHandle set;
+    int i, s, added, r = 0;
+
+    taskENTER_CRITICAL();
+    for (s = 0; s < FIO_POLL_TASKS && fio_poll_busy[s]; s++)
+        ;
+    if (s < FIO_POLL_TASKS)
+        fio_poll_busy[s] = 1;
+    taskEXIT_CRITICAL();
+    if (s == FIO_POLL_TASKS)
+        return -1;
+
+    if (!fio_poll_sets[s])
+        fio_poll_sets[s] = xQueueCreateSet(FIO_POLL_MAX);
+    set = fio_poll_sets[s];
+    if (!set) {
+        fio_poll_busy[s] = 0;
+        return -1;
+    }
+
+    for (added = 0; added < n; added++) {
+        if (!xQueueAddToSet(events[added], set)) {
+            /* Either given since the descriptor was checked, so there is
+             * no need to wait, or in the set of another fio_poll(). */
+            if (!uxQueueMessagesWaiting(events[added]))
+                r = -1;
+            break;
+        }
+    }
+    if (added == n)
+        xQueueSelectFromSet(set, ticks);
+
+    /* The descriptors are checked again anyway, so the events given
+     * meanwhile can be dropped, and their handles with them, to leave the
+     * set empty for the next call. */
+    for (i = 0; i < added; i++) {
+        taskENTER_CRITICAL();
+        xSemaphoreTake(events[i], 0);
+        xQueueRemoveFromSet(events[i], set);
+        taskEXIT_CRITICAL();
+    }
+    xQueueReset(set);
+    fio_poll_busy[s] = 0;
+    return r;
+}
+
+/* Waits up to timeout ms, forever if negative, for a read from one of the
+ * descriptors not to block.  Descriptors without an fdpoll, files, never
+ * block.  Returns how many have revents set, 0 on timeout or -1. */
+int fio_poll(struct fio_pollfd * fds, int n, int timeout) {
+    xSemaphoreHandle events[FIO_POLL_MAX], event;
+    portTickType ticks = timeout < 0 ? portMAX_DELAY : timeout / portTICK_RATE_MS;
+    xTimeOutType time_out;
+    struct fddef_t * f;
+    int i, j, ready, waiting;
+
+    if (n > FIO_POLL_MAX)
+        return -1;
+
+    vTaskSetTimeOutState(&time_out);
+    for (;;) {
+        ready = 0;
+        waiting = 0;
+        for (i = 0; i < n; i++) {
+            fds[i].revents = 0;
+            if (!fio_is_open_int(fds[i].fd)) {
+                fds[i].revents = FIO_POLLNVAL;
+            } else if (fds[i].events & FIO_POLLIN) {
+                f = fio_fds + fds[i].fd;
+                event = NULL;
+                if (!f->fdpoll || f->fdpoll(f->opaque, &event))
+                    fds[i].revents = FIO_POLLIN;
+                for (j = 0; event && j < waiting; j++)
+                    if (events[j] == event)
+                        event = NULL;
+                if (event && !fds[i].revents)
+                    events[waiting++] = event;
+            }
+            if (fds[i].revents)
+                ready++;
+        }
+
+        if (ready || !waiting || xTaskCheckForTimeOut(&time_out, &ticks))
+            return ready;
+        if (fio_poll_wait(events, waiting, ticks) < 0)
+            return -1;
+    }
+}
+
 #define stdin_hash 0x0BA00421
 #define stdout_hash 0x7FA08308
 #define stderr_hash 0x7FA058A3
 
 static int devfs_open(void * opaque, const char * path, int flags, int mode) {
     uint32_t h = hash_djb2((const uint8_t *) path, -1);
+    int fd;
 //    DBGOUT("devfs_open(%p, \"%s\", %i, %i)\r\n", opaque, path, flags, mode);
     switch (h) {
     case stdin_hash:
         if (flags & (O_WRONLY | O_RDWR))
             return -1;
-        return fio_open(stdin_read, NULL, NULL, NULL, NULL);
+        fd = fio_open(stdin_read, NULL, NULL, NULL, NULL);
+        fio_set_poll(fd, stdin_poll);
+        return fd;
         break;
     case stdout_hash:
         if (flags & O_RDONLY)
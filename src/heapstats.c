@@ -0,0 +1,200 @@
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dwt.h"
+#include "clib.h"
+#include <string.h>
+
+#if configUSE_HEAP_INSTRUMENTATION == 1
+
+/* Free blocks collected by one heap walk, the rest are only summed up. */
+#define HEAPMAP_BLOCKS 32
+
+struct call_site {
+    void *caller;
+    unsigned long allocs;
+    unsigned long failures;
+    unsigned long bytes;
+};
+
+static struct {
+    unsigned long allocs;
+    unsigned long frees;
+    unsigned long failures;
+    size_t min_free;
+    unsigned long boot_allocs;  /* as main() starts the scheduler */
+    size_t boot_used;
+    unsigned long boot_cycles;  /* since main() began, 0 without DWT */
+    struct call_site sites[HEAPSTATS_CALL_SITES];
+    struct call_site other;
+} heapstats = {
+    .min_free = (size_t) -1,
+};
+
+static volatile int heapstats_held;
+
+struct heap_walk {
+    size_t total;
+    size_t largest;
+    unsigned int count;
+    void *blocks[HEAPMAP_BLOCKS];
+    size_t sizes[HEAPMAP_BLOCKS];
+};
+
+void heapstats_malloc(void *p, size_t size, void *caller)
+{
+    struct call_site *site = &heapstats.other;
+    size_t free_bytes;
+    int i;
+
+    if (heapstats_held)
+        return;
+    free_bytes = xPortGetFreeHeapSize();
+    taskENTER_CRITICAL();
+    for (i = 0; i < HEAPSTATS_CALL_SITES; i++) {
+        if (heapstats.sites[i].caller == caller
+            || heapstats.sites[i].caller == NULL) {
+            site = &heapstats.sites[i];
+            site->caller = caller;
+            break;
+        }
+    }
+
+    if (p) {
+        heapstats.allocs++;
+        site->allocs++;
+        site->bytes += size;
+    } else {
+        heapstats.failures++;
+        site->failures++;
+    }
+    if (free_bytes < heapstats.min_free)
+        heapstats.min_free = free_bytes;
+    taskEXIT_CRITICAL();
+}
+
+void heapstats_free(void *p, size_t size)
+{
+    (void) size;
+
+    if (p && !heapstats_held) {
+        taskENTER_CRITICAL();
+        heapstats.frees++;
+        taskEXIT_CRITICAL();
+    }
+}
+
+void heapstats_boot_start(void)
+{
+    /* Counts from 0, unless a debugger started it before reset. */
+    if (dwt_start())
+        DWT_CYCCNT = 0;
+}
+
+void heapstats_boot(void)
+{
+    heapstats.boot_cycles = DWT_CYCCNT;
+    heapstats.boot_allocs = heapstats.allocs;
+    heapstats.boot_used = xPortGetTotalHeapSize() - xPortGetFreeHeapSize();
+}
+
+void heapstats_hold(int hold)
+{
+    heapstats_held = hold;
+}
+
+/* Runs with the scheduler suspended, so it only records. */
+static void heap_walk_block(void *block, size_t size, void *param)
+{
+    struct heap_walk *walk = param;
+
+    if (walk->count < HEAPMAP_BLOCKS) {
+        walk->blocks[walk->count] = block;
+        walk->sizes[walk->count] = size;
+    }
+    walk->count++;
+    walk->total += size;
+    if (size > walk->largest)
+        walk->largest = size;
+}
+
+static void heap_walk(struct heap_walk *walk)
+{
+    memset(walk, 0, sizeof(*walk));
+    vPortWalkFreeBlocks(heap_walk_block, walk);
+}
+
+/* 0 when all free memory is one block, approaching 100 as it splinters. */
+static unsigned int fragmentation(const struct heap_walk *walk)
+{
+    if (walk->total == 0)
+        return 0;
+    return 100 - (unsigned int) (walk->largest * 100 / walk->total);
+}
+
+void meminfo_command(int n, char *argv[])
+{
+    static struct heap_walk walk;
+    struct call_site site;
+    int i;
+
+    heap_walk(&walk);
+    taskENTER_CRITICAL();
+    if (heapstats.min_free > xPortGetFreeHeapSize())
+        heapstats.min_free = xPortGetFreeHeapSize();
+    taskEXIT_CRITICAL();
+
+    fio_printf(1, "Heap: %u total, %u free, %u min free, %u largest block\r\n",
+               (unsigned int) xPortGetTotalHeapSize(),
+               (unsigned int) xPortGetFreeHeapSize(),
+               (unsigned int) heapstats.min_free,
+               (unsigned int) walk.largest);
+    fio_printf(1, "Free blocks: %u, fragmentation %u%%\r\n",
+               walk.count, fragmentation(&walk));
+    fio_printf(1, "Boot: %lu malloc, %u bytes in use before the scheduler started",
+               heapstats.boot_allocs, (unsigned int) heapstats.boot_used);
+    if (heapstats.boot_cycles)
+        fio_printf(1, ", %lu cycles (%lu us) after main()",
+                   heapstats.boot_cycles,
+                   clock_cycles_to_us(heapstats.boot_cycles));
+    fio_printf(1, "\r\n");
+    fio_printf(1, "Calls: %lu malloc, %lu free, %lu failed, %lu live\r\n",
+               heapstats.allocs, heapstats.frees, heapstats.failures,
+               heapstats.allocs - heapstats.frees);
+
+    fio_printf(1, "Caller      Allocs  Failed  Bytes\r\n");
+    for (i = 0; i <= HEAPSTATS_CALL_SITES; i++) {
+        taskENTER_CRITICAL();
+        site = i < HEAPSTATS_CALL_SITES ? heapstats.sites[i] : heapstats.other;
+        taskEXIT_CRITICAL();
+
+        if (site.allocs == 0 && site.failures == 0)
+            continue;
+        if (i < HEAPSTATS_CALL_SITES)
+            fio_printf(1, "0x%08x  ", (unsigned int) site.caller);
+        else
+            fio_printf(1, "other       ");
+        fio_printf(1, "%6lu  %6lu  %lu\r\n",
+                   site.allocs, site.failures, site.bytes);
+    }
+}
+
+void heapmap_command(int n, char *argv[])
+{
+    static struct heap_walk walk;
+    unsigned int i;
+
+    heap_walk(&walk);
+
+    fio_printf(1, "Address     Size\r\n");
+    for (i = 0; i < walk.count && i < HEAPMAP_BLOCKS; i++)
+        fio_printf(1, "0x%08x  %u\r\n",
+                   (unsigned int) walk.blocks[i], (unsigned int) walk.sizes[i]);
+    if (walk.count > HEAPMAP_BLOCKS)
+        fio_printf(1, "... %u more\r\n", walk.count - HEAPMAP_BLOCKS);
+    fio_printf(1, "%u free blocks, %u bytes, largest %u, fragmentation %u%%\r\n",
+               walk.count, (unsigned int) walk.total,
+               (unsigned int) walk.largest, fragmentation(&walk));
+}
+
+#endif
@@ -0,0 +1,345 @@
+#include "stm32f10x.h"
+#include "stm32f10x_rcc.h"
+#include "stm32f10x_tim.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "hrtimer.h"
+#include <string.h>
+
+#if configUSE_HRTIMER == 1
+
+/* TIM2 interrupt priority, the most urgent one allowed to call the kernel. */
+#define HRTIMER_IRQ_PRIORITY \
+    (configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8 - __NVIC_PRIO_BITS))
+
+/* Expiries waiting for the daemon. */
+#define HRTIMER_QUEUE 8
+
+/* Daemon stack depth in words, the callbacks run on it. */
+#ifdef STACK_SIZE_HRT
+#define HRTIMER_STACK STACK_SIZE_HRT
+#else
+#define HRTIMER_STACK 256
+#endif
+
+/* A deadline closer than this when the compare channel is armed may already
+ * have gone past, the interrupt is raised by hand instead. */
+#define HRTIMER_MIN_DELAY 2
+
+struct hrtimer_expiry {
+    struct hrtimer *timer;
+    hrtimer_callback callback;
+    void *arg;
+    unsigned long deadline;
+    unsigned long fired;        /* hrtimer_now() in the interrupt */
+};
+
+/* Pending timers, heap[0] has the earliest deadline.  Only changed with
+ * interrupts disabled. */
+static struct hrtimer *heap[HRTIMER_MAX];
+static unsigned int heap_size;
+
+/* Counter bits above the 16 of TIM2, advanced by the update interrupt. */
+static volatile unsigned long hrtimer_high;
+
+static struct hrtimer_latency isr_latency;
+static struct hrtimer_latency callback_latency;
+
+static xQueueHandle expiries;
+#if configSUPPORT_STATIC_ALLOCATION == 1
+static xStaticQueue expiries_queue;
+static unsigned char expiries_storage[HRTIMER_QUEUE * sizeof(struct hrtimer_expiry)];
+static portSTACK_TYPE daemon_stack[HRTIMER_STACK];
+static xStaticTask daemon_task;
+#endif
+
+/* Timers may be started from interrupts at any priority, so the heap is
+ * guarded with PRIMASK rather than a kernel critical section. */
+static inline unsigned long hrtimer_irq_save(void)
+{
+    unsigned long primask;
+
+    __asm volatile ("mrs %0, primask\n"
+                    "cpsid i\n" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void hrtimer_irq_restore(unsigned long primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/* Must be called with interrupts disabled.  A pending update means the
+ * counter wrapped after hrtimer_high was last advanced. */
+static unsigned long hrtimer_read(void)
+{
+    unsigned long high = hrtimer_high;
+    unsigned long count = TIM_GetCounter(TIM2);
+
+    if (TIM_GetFlagStatus(TIM2, TIM_FLAG_Update) == SET && count < 0x8000)
+        high += 0x10000;
+    return high + count;
+}
+
+static int hrtimer_before(const struct hrtimer *a, const struct hrtimer *b)
+{
+    return (long) (a->deadline - b->deadline) < 0;
+}
+
+static int hrtimer_pending(const struct hrtimer *timer)
+{
+    return timer->index >= 0 && (unsigned int) timer->index < heap_size
+        && heap[timer->index] == timer;
+}
+
+static void heap_place(struct hrtimer *timer, unsigned int i)
+{
+    heap[i] = timer;
+    timer->index = i;
+}
+
+static void heap_sift_up(unsigned int i)
+{
+    struct hrtimer *timer = heap[i];
+
+    while (i > 0 && hrtimer_before(timer, heap[(i - 1) / 2])) {
+        heap_place(heap[(i - 1) / 2], i);
+        i = (i - 1) / 2;
+    }
+    heap_place(timer, i);
+}
+
+static void heap_sift_down(unsigned int i)
+{
+    struct hrtimer *timer = heap[i];
+    unsigned int child;
+
+    while ((child = 2 * i + 1) < heap_size) {
+        if (child + 1 < heap_size && hrtimer_before(heap[child + 1], heap[child]))
+            child++;
+        if (!hrtimer_before(heap[child], timer))
+            break;
+        heap_place(heap[child], i);
+        i = child;
+    }
+    heap_place(timer, i);
+}
+
+static void heap_insert(struct hrtimer *timer)
+{
+    heap[heap_size] = timer;
+    heap_sift_up(heap_size++);
+}
+
+static void heap_remove(struct hrtimer *timer)
+{
+    struct hrtimer *last = heap[--heap_size];
+    unsigned int i = timer->index;
+
+    timer->index = -1;
+    if (last != timer) {
+        heap_place(last, i);
+        heap_sift_up(i);
+        heap_sift_down(last->index);
+    }
+}
+
+/* Points the compare channel at the earliest deadline, with interrupts
+ * disabled.  A deadline more than 65ms away matches early, the interrupt
+ * finds nothing expired and arms the channel again. */
+static void hrtimer_arm(void)
+{
+    if (heap_size == 0) {
+        TIM_ITConfig(TIM2, TIM_IT_CC1, DISABLE);
+        return;
+    }
+
+    TIM_SetCompare1(TIM2, (uint16_t) heap[0]->deadline);
+    TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+    TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE);
+    if ((long) (heap[0]->deadline - hrtimer_read()) < HRTIMER_MIN_DELAY)
+        TIM_GenerateEvent(TIM2, TIM_EventSource_CC1);
+}
+
+void TIM2_IRQHandler(void)
+{
+    signed portBASE_TYPE woken = pdFALSE;
+    struct hrtimer_expiry expiry;
+    struct hrtimer *timer;
+    unsigned long now, primask;
+
+    traceISR_ENTER();
+
+    if (TIM_GetITStatus(TIM2, TIM_IT_Update) == SET) {
+        TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+        hrtimer_high += 0x10000;
+    }
+
+    if (TIM_GetITStatus(TIM2, TIM_IT_CC1) == SET) {
+        /* Keep out a timer started from a more urgent interrupt. */
+        primask = hrtimer_irq_save();
+        TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+        now = hrtimer_read();
+        while (heap_size && (long) (now - heap[0]->deadline) >= 0) {
+            timer = heap[0];
+            expiry.timer = timer;
+            expiry.callback = timer->callback;
+            expiry.arg = timer->arg;
+            expiry.deadline = timer->deadline;
+            expiry.fired = now;
+
+            heap_remove(timer);
+            if (timer->period) {
+                timer->deadline += timer->period;
+                heap_insert(timer);
+            }
+            if (!xQueueSendFromISR(expiries, &expiry, &woken))
+                timer->overruns++;
+        }
+        hrtimer_arm();
+        hrtimer_irq_restore(primask);
+    }
+
+    traceISR_EXIT();
+
+    portEND_SWITCHING_ISR(woken);
+}
+
+static void latency_record(struct hrtimer_latency *l, unsigned long us)
+{
+    l->count++;
+    l->total += us;
+    if (us < l->min)
+        l->min = us;
+    if (us > l->max)
+        l->max = us;
+}
+
+static void latency_reset(struct hrtimer_latency *l)
+{
+    memset(l, 0, sizeof(*l));
+    l->min = ~0UL;
+}
+
+static void hrtimer_daemon(void *pvParameters)
+{
+    struct hrtimer_expiry expiry;
+
+    for (;;) {
+        if (!xQueueReceive(expiries, &expiry, portMAX_DELAY))
+            continue;
+
+        latency_record(&isr_latency, expiry.fired - expiry.deadline);
+        latency_record(&callback_latency, hrtimer_now() - expiry.deadline);
+        expiry.callback(expiry.timer, expiry.arg);
+    }
+}
+
+void hrtimer_init(void)
+{
+    TIM_TimeBaseInitTypeDef base;
+    TIM_OCInitTypeDef compare;
+
+    latency_reset(&isr_latency);
+    latency_reset(&callback_latency);
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    expiries = xQueueCreateStatic(HRTIMER_QUEUE, sizeof(struct hrtimer_expiry),
+                                  expiries_storage, &expiries_queue);
+    xTaskCreateStatic(hrtimer_daemon, (signed portCHAR *) "HRT",
+            HRTIMER_STACK, NULL, configMAX_PRIORITIES - 1, daemon_stack,
+            &daemon_task);
+#else
+    expiries = xQueueCreate(HRTIMER_QUEUE, sizeof(struct hrtimer_expiry));
+    xTaskCreate(hrtimer_daemon, (signed portCHAR *) "HRT",
+            HRTIMER_STACK, NULL, configMAX_PRIORITIES - 1, NULL);
+#endif
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+
+    /* With APB1 at half the CPU clock, TIM2 is clocked at twice that, the
+     * CPU clock again.  Count microseconds over the full 16 bits. */
+    TIM_TimeBaseStructInit(&base);
+    base.TIM_Prescaler = SystemCoreClock / 1000000 - 1;
+    base.TIM_Period = 0xffff;
+    TIM_TimeBaseInit(TIM2, &base);
+
+    /* Channel 1 only compares, its output pin is left alone. */
+    TIM_OCStructInit(&compare);
+    compare.TIM_OCMode = TIM_OCMode_Timing;
+    TIM_OC1Init(TIM2, &compare);
+    TIM_OC1PreloadConfig(TIM2, TIM_OCPreload_Disable);
+
+    /* TIM_TimeBaseInit() raised an update to load the prescaler. */
+    TIM_ClearITPendingBit(TIM2, TIM_IT_Update | TIM_IT_CC1);
+    TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
+    NVIC_SetPriority(TIM2_IRQn, HRTIMER_IRQ_PRIORITY);
+    NVIC_EnableIRQ(TIM2_IRQn);
+    TIM_Cmd(TIM2, ENABLE);
+}
+
+unsigned long hrtimer_now(void)
+{
+    unsigned long primask = hrtimer_irq_save();
+    unsigned long now = hrtimer_read();
+
+    hrtimer_irq_restore(primask);
+    return now;
+}
+
+int hrtimer_start(struct hrtimer *timer, unsigned long delay,
+                  unsigned long period, hrtimer_callback callback, void *arg)
+{
+    unsigned long primask = hrtimer_irq_save();
+
+    if (hrtimer_pending(timer)) {
+        heap_remove(timer);
+    } else if (heap_size == HRTIMER_MAX) {
+        hrtimer_irq_restore(primask);
+        return 0;
+    }
+
+    timer->deadline = hrtimer_read() + delay;
+    timer->period = period;
+    timer->callback = callback;
+    timer->arg = arg;
+    heap_insert(timer);
+    hrtimer_arm();
+    hrtimer_irq_restore(primask);
+
+    return 1;
+}
+
+int hrtimer_cancel(struct hrtimer *timer)
+{
+    unsigned long primask = hrtimer_irq_save();
+    int pending = hrtimer_pending(timer);
+
+    if (pending) {
+        heap_remove(timer);
+        hrtimer_arm();
+    }
+    hrtimer_irq_restore(primask);
+
+    return pending;
+}
+
+void hrtimer_stats(struct hrtimer_latency *isr, struct hrtimer_latency *callback,
+                   int reset)
+{
+    /* The daemon updates them, it runs above every caller. */
+    taskENTER_CRITICAL();
+    if (isr)
+        *isr = isr_latency;
+    if (callback)
+        *callback = callback_latency;
+    if (reset) {
+        latency_reset(&isr_latency);
+        latency_reset(&callback_latency);
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif
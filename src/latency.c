@@ -0,0 +1,158 @@
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "profile.h"
+#include "clib.h"
+#include <string.h>
+
+#if configUSE_PROFILER == 1
+
+enum latency_kind {
+    LATENCY_CRITICAL,
+    LATENCY_SUSPEND,
+    LATENCY_KINDS
+};
+
+static const char *const latency_names[LATENCY_KINDS] = {
+    "interrupts masked",
+    "scheduler suspended",
+};
+
+struct latency_site {
+    void *caller;
+    unsigned long count;
+    unsigned long total;
+    unsigned long max;
+};
+
+/* Only one of each kind can be open at a time, both are outermost and
+ * neither spans a context switch. */
+static struct {
+    unsigned long start;
+    void *caller;
+    struct latency_site sites[LATENCY_CALL_SITES];
+    struct latency_site other;
+} latency[LATENCY_KINDS];
+
+/* The suspend hooks run with interrupts enabled, the critical ones already
+ * masked by BASEPRI, PRIMASK covers both the same way. */
+static inline unsigned long latency_irq_save(void)
+{
+    unsigned long primask;
+
+    __asm volatile ("mrs %0, primask\n"
+                    "cpsid i\n" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void latency_irq_restore(unsigned long primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+static void latency_enter(enum latency_kind kind, void *caller)
+{
+    unsigned long primask = latency_irq_save();
+
+    latency[kind].caller = caller;
+    latency[kind].start = profile_cycles();
+    latency_irq_restore(primask);
+}
+
+static void latency_exit(enum latency_kind kind)
+{
+    unsigned long primask = latency_irq_save();
+    unsigned long cycles = profile_cycles() - latency[kind].start;
+    struct latency_site *site = &latency[kind].other;
+    void *caller = latency[kind].caller;
+    int i;
+
+    for (i = 0; i < LATENCY_CALL_SITES; i++) {
+        if (latency[kind].sites[i].caller == caller
+            || latency[kind].sites[i].caller == NULL) {
+            site = &latency[kind].sites[i];
+            site->caller = caller;
+            break;
+        }
+    }
+
+    site->count++;
+    site->total += cycles;
+    if (cycles > site->max)
+        site->max = cycles;
+    latency_irq_restore(primask);
+}
+
+void latency_critical_enter(void *caller)
+{
+    latency_enter(LATENCY_CRITICAL, caller);
+}
+
+void latency_critical_exit(void)
+{
+    latency_exit(LATENCY_CRITICAL);
+}
+
+void latency_suspend_enter(void *caller)
+{
+    latency_enter(LATENCY_SUSPEND, caller);
+}
+
+void latency_suspend_exit(void)
+{
+    latency_exit(LATENCY_SUSPEND);
+}
+
+void latency_prof_reset(void)
+{
+    unsigned long primask = latency_irq_save();
+    int kind;
+
+    /* An interval open right now is kept, its start stays valid. */
+    for (kind = 0; kind < LATENCY_KINDS; kind++) {
+        memset(latency[kind].sites, 0, sizeof(latency[kind].sites));
+        memset(&latency[kind].other, 0, sizeof(latency[kind].other));
+    }
+    latency_irq_restore(primask);
+}
+
+void latency_prof_report(void)
+{
+    struct latency_site sites[LATENCY_CALL_SITES + 1], site;
+    unsigned long primask;
+    int kind, i, j, n;
+
+    for (kind = 0; kind < LATENCY_KINDS; kind++) {
+        /* Copied out first, printing takes critical sections of its own. */
+        primask = latency_irq_save();
+        memcpy(sites, latency[kind].sites, sizeof(latency[kind].sites));
+        sites[LATENCY_CALL_SITES] = latency[kind].other;
+        latency_irq_restore(primask);
+
+        /* Worst first, insertion sort over a handful of entries. */
+        n = 0;
+        for (i = 0; i <= LATENCY_CALL_SITES; i++) {
+            if (sites[i].count == 0)
+                continue;
+            site = sites[i];
+            for (j = n; j > 0 && sites[j - 1].max < site.max; j--)
+                sites[j] = sites[j - 1];
+            sites[j] = site;
+            n++;
+        }
+
+        fio_printf(1, "Longest with %s\r\n", latency_names[kind]);
+        fio_printf(1, "caller          count       avg       max    max us\r\n");
+        for (i = 0; i < n; i++) {
+            if (sites[i].caller)
+                fio_printf(1, "0x%08x  ", (unsigned int) sites[i].caller);
+            else
+                fio_printf(1, "other       ");
+            fio_printf(1, "%7lu %9lu %9lu %9lu\r\n", sites[i].count,
+                       sites[i].total / sites[i].count, sites[i].max,
+                       clock_cycles_to_us(sites[i].max));
+        }
+    }
+}
+
+#endif
@@ -40,6 +40,7 @@
  */
 #include <FreeRTOS.h>
 #include "linenoise.h"
+#include "profile.h"
 
 #define LINENOISE_DEFAULT_HISTORY_MAX_LEN 10
 #define LINENOISE_MAX_LINE                61
@@ -107,6 +108,14 @@ static void __free(void *ptr){
     /* if equal to 0x1, nothing to do */
 }
 
+/* warpper for pvPortRealloc(), understands the magic number of __malloc() */
+static void *__realloc(void *ptr, size_t size){
+    if(ptr == (void *)0x1) ptr = NULL;
+    if(size) return pvPortRealloc(ptr, size);
+    __free(ptr);
+    return (void *)0x1;
+}
+
 /* Clear the screen. Used to handle ctrl+l */
 void linenoiseClearScreen(void) {
     if (fio_write(1,"\x1b[H\x1b[2J",7) <= 0) {
@@ -195,8 +204,8 @@ void linenoiseAddCompletion(linenoiseCompletions *lc, const char *str) {
     copy = __malloc(len+1);
     if (copy == NULL) return;
     memcpy(copy,str,len+1);
-    __free(lc->cvec);
-    cvec = __malloc(sizeof(char*)*(lc->len+1));
+    /* Grows in place when the heap can, the old entries are kept. */
+    cvec = __realloc(lc->cvec,sizeof(char*)*(lc->len+1));
     if (cvec == NULL) {
         __free(copy);
         return;
@@ -209,6 +218,7 @@ void linenoiseAddCompletion(linenoiseCompletions *lc, const char *str) {
  * Rewrite the currently edited line accordingly to the buffer content,
  * cursor position, and number of columns of the terminal. */
 static void refreshLine(struct linenoiseState *l) {
+    PROFILE_BEGIN(refresh_line);
     size_t plen = strlen(l->prompt);
     int fd = l->ofd;
     char *buf = l->buf;
@@ -228,6 +238,7 @@ static void refreshLine(struct linenoiseState *l) {
     fio_write(fd, buf, len);
     /* Move cursor to original position. */
     fio_printf(fd, "\r\x1b[%dC", (int)(pos+plen));
+    PROFILE_END(refresh_line);
 }
 /* Insert the character 'c' at cursor current position.
  *
@@ -586,10 +597,9 @@ int linenoiseHistoryAdd(const char *line) {
     /* Add an heap allocated copy of the line in the history.
      * If we reached the max length, remove the older line. */
     size_t linelen = strlen(line);
-    linecopy = __malloc(linelen);
+    linecopy = __malloc(linelen+1);
     if(linecopy == NULL)return 0; /* allocate failed, not added */
-    strncpy(linecopy, line, linelen);
-    if (!linecopy) return 0;
+    memcpy(linecopy, line, linelen+1);
     if (history_len == history_max_len) {
         __free(history[0]);
         memmove(history,history+1,sizeof(char*)*(history_max_len-1));
@@ -607,18 +617,18 @@ int linenoiseHistorySetMaxLen(int len) {
     char **new;
     if (len < 1) return 0;
     if (history) {
-        int tocopy = history_len;
-        new = __malloc(sizeof(char*)*len);
-        if (new == NULL) return 0;
-        /* If we can't copy everything, __free the elements we'll not use. */
-        if (len < tocopy) {
+        /* If we can't keep everything, __free the oldest elements and move
+         * the rest to the front before shrinking. */
+        if (len < history_len) {
             int j;
-            for (j = 0; j < tocopy-len; j++) __free(history[j]);
-            tocopy = len;
+            for (j = 0; j < history_len-len; j++) __free(history[j]);
+            memmove(history,history+(history_len-len),sizeof(char*)*len);
+            history_len = len;
         }
-        memset(new,0,sizeof(char*)*len);
-        memcpy(new,history+(history_len-tocopy), sizeof(char*)*tocopy);
-        __free(history);
+        new = __realloc(history,sizeof(char*)*len);
+        if (new == NULL) return 0;
+        if (len > history_max_len)
+            memset(new+history_max_len,0,sizeof(char*)*(len-history_max_len));
         history = new;
     }
     history_max_len = len;
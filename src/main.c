@@ -6,6 +6,8 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "stream_buffer.h"
+#include "deferred.h"
 #include <string.h>
 
 /* Filesystem includes */
@@ -16,38 +18,151 @@
 #include "clib.h"
 #include "shell.h"
 #include "host.h"
+#include "stackstats.h"
+#include "hrtimer.h"
+#include "profile.h"
 
 /* _sromfs symbol can be found in main.ld linker script
  * it contains file system structure of test_romfs directory
  */
 extern const unsigned char _sromfs;
 
-volatile xSemaphoreHandle serial_tx_wait_sem = NULL;
-/* Add for serial input */
-volatile xQueueHandle serial_rx_queue = NULL;
+/* Stack depths in words of the tasks created by main(), unless taken from
+ * the header "stacks save" writes, see mk/stacks.mk. */
+#ifdef STACK_SIZE_CLI
+#define CLI_STACK STACK_SIZE_CLI
+#else
+#define CLI_STACK 512
+#endif
+#ifdef STACK_SIZE_LOGGER
+#define LOGGER_STACK STACK_SIZE_LOGGER
+#else
+#define LOGGER_STACK 256
+#endif
+
+/* Bytes received but not read yet.  The shell reads them as they come, this
+ * only has to cover a paste while it is busy with a command. */
+#define SERIAL_RX_BUFFER 32
+
+/* The USART driver signals the transmitting task with a direct notification
+ * instead of a semaphore.  The state lives in the variables below, guarded by
+ * critical sections; the interrupt handler notifies the task registered as
+ * waiting, if any, whenever the state changes.  A waiter rechecks the state
+ * each time it wakes, so a stray notification is harmless.
+ *
+ * With the deferred daemon the interrupt handler only reads and writes the
+ * USART registers, the rest of each interrupt is a function it pends for the
+ * daemon, see serial_tx_done() and serial_rx_byte(). */
+
+/* A byte is in the transmit data register. */
+static volatile int serial_tx_busy;
+static volatile xTaskHandle serial_tx_waiter;
+
+/* Received bytes, passed on by the interrupt handler and read by the shell. */
+static xStreamBufferHandle serial_rx_stream;
+
+/* Given with every byte received, for fio_poll(), see recv_byte_poll(). */
+static xSemaphoreHandle serial_rx_event;
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+/* The tasks main() creates live for as long as the system runs, so their
+ * stacks and control blocks are static rather than taken from the heap. */
+static portSTACK_TYPE cli_stack[CLI_STACK];
+static xStaticTask cli_task;
+static portSTACK_TYPE logger_stack[LOGGER_STACK];
+static xStaticTask logger_task;
+#endif
+
+#if configUSE_DEFERRED_CALLS == 1
+/* The transmit data register has room for the next byte. */
+static void serial_tx_done(void *unused, unsigned long unused2)
+{
+    xTaskHandle task;
+
+    taskENTER_CRITICAL();
+    serial_tx_busy = 0;
+    task = serial_tx_waiter;
+    serial_tx_waiter = NULL;
+    taskEXIT_CRITICAL();
+
+    if (task)
+        xTaskNotifyGive(task);
+}
+
+static void serial_rx_byte(void *unused, unsigned long byte)
+{
+    char msg = byte;
+
+    /* If the receive buffer is full, freeze! */
+    if (!xStreamBufferSend(serial_rx_stream, &msg, 1, 0))
+        while(1);
+    xSemaphoreGive(serial_rx_event);
+}
+#else
+static void serial_notify_from_isr(volatile xTaskHandle *waiter,
+                                   signed portBASE_TYPE *woken)
+{
+    xTaskHandle task = *waiter;
+
+    if (task) {
+        *waiter = NULL;
+        vTaskNotifyGiveFromISR(task, woken);
+    }
+}
+#endif
+
+/* Called and returns inside a critical section, which is left while the
+ * task blocks.  Only one task can be registered as the waiter, so where
+ * several tasks may wait a timeout lets one pushed out by another check
+ * again. */
+static void serial_wait(volatile xTaskHandle *waiter, portTickType timeout)
+{
+    *waiter = xTaskGetCurrentTaskHandle();
+    taskEXIT_CRITICAL();
+    ulTaskNotifyTake(pdTRUE, timeout);
+    taskENTER_CRITICAL();
+}
 
 /* IRQ handler to handle USART2 interruptss (both transmit and receive
  * interrupts). */
 void USART2_IRQHandler()
 {
-    static signed portBASE_TYPE xHigherPriorityTaskWoken;
+    signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    /* The time spent in the handler, see "prof regions". */
+    PROFILE_BEGIN(usart2_isr);
+    traceISR_ENTER();
 
     /* If this interrupt is for a transmit... */
     if (USART_GetITStatus(USART2, USART_IT_TXE) != RESET) {
-        /* "give" the serial_tx_wait_sem semaphore to notfiy processes
-         * that the buffer has a spot free for the next byte.
-         */
-        xSemaphoreGiveFromISR(serial_tx_wait_sem, &xHigherPriorityTaskWoken);
-
         /* Diables the transmit interrupt. */
         USART_ITConfig(USART2, USART_IT_TXE, DISABLE);
+
+        /* The buffer has a spot free for the next byte. */
+#if configUSE_DEFERRED_CALLS == 1
+        /* If the daemon is this far behind, freeze! */
+        if (!xPendFunctionCallFromISR(serial_tx_done, NULL, 0,
+                                      &xHigherPriorityTaskWoken))
+            while(1);
+#else
+        serial_tx_busy = 0;
+        serial_notify_from_isr(&serial_tx_waiter, &xHigherPriorityTaskWoken);
+#endif
         /* If this interrupt is for a receive... */
     }else if(USART_GetITStatus(USART2, USART_IT_RXNE) != RESET){
         char msg = USART_ReceiveData(USART2);
 
-        /* If there is an error when queueing the received byte, freeze! */
-        if(!xQueueSendToBackFromISR(serial_rx_queue, &msg, &xHigherPriorityTaskWoken))
+#if configUSE_DEFERRED_CALLS == 1
+        if (!xPendFunctionCallFromISR(serial_rx_byte, NULL, msg,
+                                      &xHigherPriorityTaskWoken))
             while(1);
+#else
+        /* If the receive buffer is full, freeze! */
+        if (!xStreamBufferSendFromISR(serial_rx_stream, &msg, 1,
+                                      &xHigherPriorityTaskWoken))
+            while(1);
+        xSemaphoreGiveFromISR(serial_rx_event, &xHigherPriorityTaskWoken);
+#endif
     }
     else {
         /* Only transmit and receive interrupts should be enabled.
@@ -56,6 +171,9 @@ void USART2_IRQHandler()
         while(1);
     }
 
+    traceISR_EXIT();
+    PROFILE_END(usart2_isr);
+
     if (xHigherPriorityTaskWoken) {
         taskYIELD();
     }
@@ -63,11 +181,15 @@ void USART2_IRQHandler()
 
 void send_byte(char ch)
 {
-    /* Wait until the RS232 port can receive another byte (this semaphore
-     * is "given" by the RS232 port interrupt when the buffer has room for
-     * another byte.
+    /* Wait until the RS232 port can receive another byte (the RS232 port
+     * interrupt clears serial_tx_busy when the buffer has room for another
+     * byte).
      */
-    while (!xSemaphoreTake(serial_tx_wait_sem, portMAX_DELAY));
+    taskENTER_CRITICAL();
+    while (serial_tx_busy)
+        serial_wait(&serial_tx_waiter, 1);
+    serial_tx_busy = 1;
+    taskEXIT_CRITICAL();
 
     /* Send the byte and enable the transmit interrupt (it is disabled by
      * the interrupt).
@@ -80,15 +202,31 @@ char recv_byte()
 {
     USART_ITConfig(USART2, USART_IT_RXNE, ENABLE);
     char msg;
-    while(!xQueueReceive(serial_rx_queue, &msg, portMAX_DELAY));
+
+    /* Only the shell reads, it can wait as long as it takes. */
+    while (!xStreamBufferReceive(serial_rx_stream, &msg, 1, portMAX_DELAY));
     return msg;
 }
 
+/* Nonzero if recv_byte() would not block.  Otherwise *event is the semaphore
+ * the interrupt handler gives when the next byte arrives, taken before the
+ * check so that a byte arriving after it is not missed. */
+int recv_byte_poll(xSemaphoreHandle *event)
+{
+    USART_ITConfig(USART2, USART_IT_RXNE, ENABLE);
+
+    xSemaphoreTake(serial_rx_event, 0);
+    *event = serial_rx_event;
+    return !xStreamBufferIsEmpty(serial_rx_stream);
+}
+
 void system_logger(void *pvParameters)
 {
     static signed portCHAR output[512] = {0};
     char *tag = "\nName          State   Priority  Stack  Num\n*******************************************\n";
-    int handle, error;
+    char stamp[24];
+    unsigned long now, us;
+    int handle, error, periodic = 0;
     const portTickType xDelay = 5 * 100;
 
     host_action(SYS_SYSTEM, "mkdir -p output");
@@ -99,7 +237,20 @@ void system_logger(void *pvParameters)
         return;
     }
 
+#if configUSE_EDF_SCHEDULING == 1
+    /* Stays at its fixed priority, only its deadline misses are tracked,
+     * see "ps".  Without the memory for that it just sleeps. */
+    periodic = xTaskSetPeriodic(NULL, xDelay, xDelay) == pdPASS;
+#endif
+
     while(1) {
+        now = clock_now_s(&us);
+        snprintf(stamp, sizeof(stamp), "\n%lu.%06lu s", now, us);
+        error = host_action(SYS_WRITE, handle, stamp, strlen(stamp));
+        if(error != 0) {
+            fio_printf(1, "Write file error! Remain %d bytes didn't write in the file.\n\r", error);
+            break;
+        }
         error = host_action(SYS_WRITE, handle, (void *)tag, strlen(tag));
         if(error != 0) {
             fio_printf(1, "Write file error! Remain %d bytes didn't write in the file.\n\r", error);
@@ -111,7 +262,10 @@ void system_logger(void *pvParameters)
             fio_printf(1, "Write file error! Remain %d bytes didn't write in the file.\n\r", error);
             break;
         }
-        vTaskDelay(xDelay);
+        if (periodic)
+            vTaskWaitForNextPeriod();
+        else
+            vTaskDelay(xDelay);
     }
     host_action(SYS_CLOSE, handle);
     vTaskDelete(NULL);
@@ -119,6 +273,14 @@ void system_logger(void *pvParameters)
 
 int main()
 {
+#if configUSE_HEAP_INSTRUMENTATION == 1
+    heapstats_boot_start();
+#endif
+    stackstats_paint_msp();
+
+    serial_rx_stream = xStreamBufferCreate(SERIAL_RX_BUFFER, 1);
+    vSemaphoreCreateBinary(serial_rx_event);
+
     init_rs232();
     enable_rs232_interrupts();
     enable_rs232();
@@ -128,23 +290,37 @@ int main()
 
     register_romfs("romfs", &_sromfs);
 
-    /* Create the queue used by the serial task.  Messages for write to
-     * the RS232. */
-    vSemaphoreCreateBinary(serial_tx_wait_sem);
-    /* Add for serial input 
-     * Reference: www.freertos.org/a00116.html */
-    serial_rx_queue = xQueueCreate(1, sizeof(char));
-
     register_devfs();
     /* Create a task to output text read from romfs. */
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    xTaskCreateStatic(command_prompt,
+            (signed portCHAR *) "CLI",
+            CLI_STACK, NULL, tskIDLE_PRIORITY + 2, cli_stack, &cli_task);
+#else
     xTaskCreate(command_prompt,
             (signed portCHAR *) "CLI",
-            512 /* stack size */, NULL, tskIDLE_PRIORITY + 2, NULL);
+            CLI_STACK, NULL, tskIDLE_PRIORITY + 2, NULL);
+#endif
 
     /* Create a task to record system log. */
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    xTaskCreateStatic(system_logger,
+            (signed portCHAR *) "Logger",
+            LOGGER_STACK, NULL, tskIDLE_PRIORITY + 1, logger_stack,
+            &logger_task);
+#else
     xTaskCreate(system_logger,
             (signed portCHAR *) "Logger",
-            256 /* stack size */, NULL, tskIDLE_PRIORITY + 1, NULL);
+            LOGGER_STACK, NULL, tskIDLE_PRIORITY + 1, NULL);
+#endif
+
+#if configUSE_HRTIMER == 1
+    hrtimer_init();
+#endif
+
+#if configUSE_HEAP_INSTRUMENTATION == 1
+    heapstats_boot();
+#endif
 
     /* Start running the tasks. */
     vTaskStartScheduler();
@@ -155,3 +331,28 @@ int main()
 void vApplicationTickHook()
 {
 }
+
+static void send_byte_polled(char ch)
+{
+    while (USART_GetFlagStatus(USART2, USART_FLAG_TXE) == RESET);
+    USART_SendData(USART2, ch);
+}
+
+/* Called on a context switch away from a task that ran past the end of its
+ * stack.  Whatever lay below it is corrupt, so name the task on the console
+ * without the driver or the scheduler, and stop. */
+void vApplicationStackOverflowHook(xTaskHandle *pxTask, signed char *pcTaskName)
+{
+    const char *msg = "\r\nStack overflow in task ";
+    int i;
+
+    (void) pxTask;
+    taskDISABLE_INTERRUPTS();
+    while (*msg)
+        send_byte_polled(*msg++);
+    for (i = 0; i < configMAX_TASK_NAME_LEN && pcTaskName[i]; i++)
+        send_byte_polled(pcTaskName[i]);
+    send_byte_polled('\r');
+    send_byte_polled('\n');
+    while(1);
+}
@@ -1,143 +1,346 @@
 #include "FreeRTOS.h"
 #include "fio.h"
 #include "clib.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Deterministic allocator benchmark.
+ *
+ * Each trace is an allocation pattern driven by a seeded PRNG, so every run
+ * (and every HEAP_IMPL) replays exactly the same sequence of malloc and free
+ * calls.  Only the allocator calls are timed, the block contents are filled
+ * and verified outside the timed region to catch corruption.  Heap
+ * instrumentation is held for the whole run, its hooks would otherwise be
+ * timed along with the allocator.
+ *
+ * The same file builds on the host with MMTEST_HOST defined, see
+ * tool/mmtest-host.c and "make mmbench".
+ */
 
 /* heap_XX.c */
 void *pvPortMalloc(size_t xWantedSize);
 void vPortFree(void *pv);
+void *pvPortRealloc(void *pv, size_t xWantedSize);
 size_t xPortGetFreeHeapSize(void);
 
+#define MMTEST_SLOTS 64
+
+/* Candidates in the completion list benchmark, and how often it runs. */
+#define MMTEST_COMPLETIONS 64
+#define MMTEST_COMPLETION_RUNS 8
+
+/* Fragmentation is sampled every this many operations, walking the heap
+ * is far more expensive than the operations being measured. */
+#define MMTEST_FRAG_PERIOD 16
+
+enum mmtest_pattern {
+    MMTEST_CHURN,   /* random malloc/free with a bounded live set */
+    MMTEST_RAMP,    /* fill until full, then drain in random order */
+    MMTEST_KERNEL,  /* control block plus stack/storage pairs */
+};
+
+struct mmtest_trace {
+    const char *name;
+    enum mmtest_pattern pattern;
+    unsigned int ops;
+    unsigned int live;      /* slots in use at most */
+    unsigned int min_size;
+    unsigned int max_size;
+};
+
+static const struct mmtest_trace traces[] = {
+    { "small",  MMTEST_CHURN,  2000, 32,  8,   64 },
+    { "mixed",  MMTEST_CHURN,  2000, 48,  8,  512 },
+    { "ramp",   MMTEST_RAMP,   2000, 64, 16,  256 },
+    { "kernel", MMTEST_KERNEL, 1000, 16, 64, 2048 },
+};
+
+struct mmtest_result {
+    unsigned long mallocs, frees, failures;
+    unsigned long malloc_cycles, malloc_max;
+    unsigned long free_cycles, free_max;
+    unsigned int peak_frag;
+    size_t min_free;
+    int corrupt;
+};
+
 struct slot {
-    void *pointer;
+    unsigned char *pointer;
     unsigned int size;
-    unsigned int lfsr;
+    unsigned char fill;
 };
 
-#define CIRCBUFSIZE 5000
-unsigned int write_pointer, read_pointer;
-static struct slot slots[CIRCBUFSIZE];
-static unsigned int lfsr = 0xACE1;
+static struct slot slots[MMTEST_SLOTS];
+static unsigned int seed;
+
+static unsigned int prng(void)
+{
+    /* xorshift32 */
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static unsigned int prng_range(unsigned int min, unsigned int max)
+{
+    return min + prng() % (max - min + 1);
+}
+
+/* Cycles on the target, nanoseconds on the host. */
+#ifdef MMTEST_HOST
+unsigned long mmtest_cycles(void);
+#else
+#define mmtest_cycles clock_cycles
+#endif
 
+#if configUSE_HEAP_INSTRUMENTATION == 1
+struct frag_walk {
+    size_t total;
+    size_t largest;
+};
 
-static unsigned int circbuf_size(void)
+static void frag_block(void *block, size_t size, void *param)
 {
-    return (write_pointer + CIRCBUFSIZE - read_pointer) % CIRCBUFSIZE;
+    struct frag_walk *walk = param;
+
+    walk->total += size;
+    if (size > walk->largest)
+        walk->largest = size;
 }
 
-static void write_cb(struct slot foo)
+static unsigned int heap_fragmentation(void)
 {
-    if (circbuf_size() == CIRCBUFSIZE - 1) {
-        fio_printf(2, "\r\ncircular buffer overflow\r\n");
-        //exit(1);
-    }
-    slots[write_pointer++] = foo;
-    write_pointer %= CIRCBUFSIZE;
+    struct frag_walk walk = { 0, 0 };
+
+    vPortWalkFreeBlocks(frag_block, &walk);
+    if (walk.total == 0)
+        return 0;
+    return 100 - (unsigned int) (walk.largest * 100 / walk.total);
 }
+#endif
 
-static struct slot read_cb(void)
+static int slot_alloc(struct slot *s, unsigned int size,
+                      struct mmtest_result *r)
 {
-    struct slot foo;
-    if (write_pointer == read_pointer) {
-        // circular buffer is empty
-        return (struct slot){ .pointer=NULL, .size=0, .lfsr=0 };
+    unsigned long start, cycles;
+    unsigned int i;
+
+    start = mmtest_cycles();
+    s->pointer = pvPortMalloc(size);
+    cycles = mmtest_cycles() - start;
+
+    r->mallocs++;
+    r->malloc_cycles += cycles;
+    if (cycles > r->malloc_max)
+        r->malloc_max = cycles;
+    if (!s->pointer) {
+        r->failures++;
+        return 0;
     }
-    foo = slots[read_pointer++];
-    read_pointer %= CIRCBUFSIZE;
-    return foo;
+
+    s->size = size;
+    s->fill = (unsigned char) prng();
+    for (i = 0; i < size; i++)
+        s->pointer[i] = (unsigned char) (s->fill + i);
+    if (xPortGetFreeHeapSize() < r->min_free)
+        r->min_free = xPortGetFreeHeapSize();
+    return 1;
 }
 
+static void slot_free(struct slot *s, struct mmtest_result *r)
+{
+    unsigned long start, cycles;
+    unsigned int i;
 
-// Get a pseudorandom number generator from Wikipedia
-static int prng(void) __attribute__((naked));
-static int prng(void){
-
-    /*static unsigned int bit;
-    // taps: 16 14 13 11; characteristic polynomial: x^16 + x^14 + x^13 + x^11 + 1 
-    bit  = ((lfsr >> 0) ^ (lfsr >> 2) ^ (lfsr >> 3) ^ (lfsr >> 5) ) & 1;
-    lfsr =  (lfsr >> 1) | (bit << 15);*/
-    //return lfsr & 0xffff;
-   
-    /* ASM Impletation
-	movt r3, higer 16 bits of &lfsr
-	movw r3, lower 16 bits of &lfsr
-	;r3=*r3 == lfsr
-	ldr r3, [r3, #0]
-	;r2 = r3 >> 2
-	mov.w r2, r3, lsr #2
-
-	movt r3, higer 16 bits of &lfsr
-	movw r3, lower 16 bits of &lfsr
-	ldr r3, [r3, #0]
-	(lfsr >> 0) ^ (lfsr >> 2)
-	eors r2, r3
-	...
-    */
-
-
-    __asm__ (
-	"mov r0, %1\t\n" // r0 = lfsr
-	"eor r3, r3\t\n" // r3 = 0 
-	"eor r3, r0\t\n" // r3 ^= lfsr
-	"mov r2, r0, lsr #2\t\n"
-	"eor r3, r2\t\n" // r3 ^= lfsr>>2 
-	"mov r2, r0, lsr #3\t\n"
-	"eor r3, r2\t\n" // r3 ^= lfsr>>3 
-	"mov r2, r0, lsr #5\t\n"
-	"eor r3, r2\t\n" // r3 ^= lfsr>>5 
-	"and r3, #0x1\t\n" //bit = r3 & 1
-	"mov r3, r3, lsl #15\t\n" //r3=bit<<15
-	"mov r2, r0, lsr #1\t\n" // r2= lfsr>>1
-	"orr r2, r3\t\n"
-	"mov %0, r2\t\n"
-	"mov r0, r2, lsl #16\t\n" // r0 = lfsr(r2) & 0xFFFF
-	"mov r0, r0, lsr #16\t\n"
-    : "=r" (lfsr)
-    : "r" (lfsr)
-    : "r2", "r0");
-
-    __asm__("bx lr\t\n");
-
-    return 0;
+    for (i = 0; i < s->size; i++)
+        if (s->pointer[i] != (unsigned char) (s->fill + i))
+            r->corrupt = 1;
+
+    start = mmtest_cycles();
+    vPortFree(s->pointer);
+    cycles = mmtest_cycles() - start;
+
+    r->frees++;
+    r->free_cycles += cycles;
+    if (cycles > r->free_max)
+        r->free_max = cycles;
+    s->pointer = NULL;
 }
 
+/* Picks a random slot among the first n slots a stride apart, used or not
+ * as requested.  Returns its index or -1. */
+static int pick_slot(unsigned int n, unsigned int stride, int used)
+{
+    unsigned int i, k, start = prng() % n;
 
-void mmtest_command(int n, char *argv[]){
-    int i, size;
-    char *p;
-
-    fio_printf(2, "\r\n");
-    while (1) {
-        size = prng() & 0x7FF;
-        fio_printf(1, "try to allocate %d bytes\r\n", size);
-        p = (char *) pvPortMalloc(size);
-        fio_printf(1, "malloc returned 0x%x\r\n", p);
-        if (p == NULL) {
-            // can't do new allocations until we free some older ones
-            while (circbuf_size() > 0) {
-                // confirm that data didn't get trampled before freeing
-                struct slot foo = read_cb();
-                p = foo.pointer;
-                lfsr = foo.lfsr;  // reset the PRNG to its earlier state
-                size = foo.size;
-                fio_printf(1, "free a block, size %d\r\n", size);
-                for (i = 0; i < size; i++) {
-                    unsigned char u = p[i];
-                    unsigned char v = (unsigned char) prng();
-                    if (u != v) {
-                        fio_printf(1, "OUCH: u=%x, v=%x\r\n", u, v);
-                        return ;
-                    }
-                }
-                vPortFree(p);
-                if ((prng() & 1) == 0) break;
+    for (i = 0; i < n; i++) {
+        k = (start + i) % n * stride;
+        if ((slots[k].pointer != NULL) == used)
+            return k;
+    }
+    return -1;
+}
+
+static void mmtest_run(const struct mmtest_trace *t, struct mmtest_result *r)
+{
+    unsigned int op, i;
+    int filling = 1, want, k;
+
+    memset(r, 0, sizeof(*r));
+    memset(slots, 0, sizeof(slots));
+    r->min_free = xPortGetFreeHeapSize();
+
+    for (op = 0; op < t->ops; op++) {
+        switch (t->pattern) {
+        case MMTEST_CHURN:
+            want = prng() & 1;
+            k = pick_slot(t->live, 1, want);
+            if (k < 0)
+                k = pick_slot(t->live, 1, !want);
+            if (slots[k].pointer)
+                slot_free(&slots[k], r);
+            else
+                slot_alloc(&slots[k], prng_range(t->min_size, t->max_size), r);
+            break;
+        case MMTEST_RAMP:
+            k = pick_slot(t->live, 1, !filling);
+            if (filling && (k < 0
+                || !slot_alloc(&slots[k], prng_range(t->min_size, t->max_size), r)))
+                filling = 0;
+            else if (!filling) {
+                if (k < 0)
+                    filling = 1;
+                else
+                    slot_free(&slots[k], r);
             }
+            break;
+        case MMTEST_KERNEL:
+            /* Even slots hold control blocks, odd ones their stack or
+             * queue storage, allocated and released as a pair. */
+            want = prng() & 1;
+            k = pick_slot(t->live / 2, 2, want);
+            if (k < 0)
+                k = pick_slot(t->live / 2, 2, !want);
+            if (slots[k].pointer) {
+                slot_free(&slots[k + 1], r);
+                slot_free(&slots[k], r);
+            } else if (slot_alloc(&slots[k], t->min_size + 16, r)
+                       && !slot_alloc(&slots[k + 1],
+                                      prng_range(t->min_size, t->max_size) & ~3, r))
+                slot_free(&slots[k], r);
+            break;
+        }
+
+#if configUSE_HEAP_INSTRUMENTATION == 1
+        if (op % MMTEST_FRAG_PERIOD == 0) {
+            unsigned int frag = heap_fragmentation();
+            if (frag > r->peak_frag)
+                r->peak_frag = frag;
+        }
+#endif
+    }
+
+    for (i = 0; i < MMTEST_SLOTS; i++)
+        if (slots[i].pointer)
+            slot_free(&slots[i], r);
+}
+
+/* Builds a completion list the way linenoiseAddCompletion() does, a copy of
+ * every candidate plus a pointer array grown by one entry each time.  The
+ * array is either resized with pvPortRealloc() or, as linenoise used to,
+ * replaced by a new one with the old entries copied over.  Returns the cycles
+ * spent, 0 if the heap ran out. */
+static unsigned long mmtest_completions(int use_realloc)
+{
+    char **cvec = NULL, **grown;
+    char *copy;
+    unsigned long start, cycles = 0;
+    unsigned int i, len, built;
+
+    for (built = 0; built < MMTEST_COMPLETIONS; built++) {
+        len = prng_range(4, 16);
+
+        start = mmtest_cycles();
+        copy = pvPortMalloc(len);
+        if (use_realloc) {
+            grown = pvPortRealloc(cvec, sizeof(char *) * (built + 1));
         } else {
-            fio_printf(1, "allocate a block, size %d\r\n", size);
-            write_cb((struct slot){.pointer=p, .size=size, .lfsr=lfsr});
-            for (i = 0; i < size; i++) {
-                p[i] = (unsigned char) prng();
-            }
+            grown = pvPortMalloc(sizeof(char *) * (built + 1));
+            if (grown && cvec)
+                memcpy(grown, cvec, sizeof(char *) * built);
+            if (grown)
+                vPortFree(cvec);
+        }
+        cycles += mmtest_cycles() - start;
+
+        if (grown)
+            cvec = grown;
+        if (!copy || !grown) {
+            vPortFree(copy);
+            cycles = 0;
+            break;
         }
+        memset(copy, 'a', len);
+        cvec[built] = copy;
+    }
+
+    for (i = 0; i < built; i++)
+        vPortFree(cvec[i]);
+    vPortFree(cvec);
+    return cycles;
+}
+
+void mmtest_command(int n, char *argv[])
+{
+    struct mmtest_result r;
+    unsigned int i;
+
+#if configUSE_HEAP_INSTRUMENTATION == 1
+    heapstats_hold(1);
+#endif
+    fio_printf(1, "trace   mallocs  fail%%  malloc avg/max   free avg/max     frag%%  minfree\r\n");
+    for (i = 0; i < sizeof(traces) / sizeof(traces[0]); i++) {
+        seed = n > 1 ? (unsigned int) atoi(argv[1]) : 0x2545f491;
+        if (seed == 0)
+            seed = 1;
+        mmtest_run(&traces[i], &r);
+
+        fio_printf(1, "%-6s  %7lu  %5lu  %6lu/%-8lu  %6lu/%-8lu  ",
+                   traces[i].name, r.mallocs,
+                   r.mallocs ? r.failures * 100 / r.mallocs : 0,
+                   r.mallocs ? r.malloc_cycles / r.mallocs : 0, r.malloc_max,
+                   r.frees ? r.free_cycles / r.frees : 0, r.free_max);
+#if configUSE_HEAP_INSTRUMENTATION == 1
+        fio_printf(1, "%5u  ", r.peak_frag);
+#else
+        fio_printf(1, "    -  ");
+#endif
+        fio_printf(1, "%7u%s\r\n", (unsigned int) r.min_free,
+                   r.corrupt ? "  CORRUPT" : "");
     }
 
+    /* Best of a few runs, the first one also pays for cold caches. */
+    for (i = 0; i < 2; i++) {
+        unsigned long best = ~0UL, cycles;
+        int run;
+
+        for (run = 0; run < MMTEST_COMPLETION_RUNS; run++) {
+            seed = n > 1 ? (unsigned int) atoi(argv[1]) : 0x2545f491;
+            if (seed == 0)
+                seed = 1;
+            cycles = mmtest_completions(!i);
+            if (cycles < best)
+                best = cycles;
+        }
+        fio_printf(1, "%d completions, %-11s ", MMTEST_COMPLETIONS,
+                   i ? "malloc+copy" : "realloc");
+        if (best)
+            fio_printf(1, "%lu\r\n", best);
+        else
+            fio_printf(1, "out of memory\r\n");
+    }
+#if configUSE_HEAP_INSTRUMENTATION == 1
+    heapstats_hold(0);
+#endif
 }
@@ -0,0 +1,144 @@
+#include "stm32f10x.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred.h"
+
+#include "profile.h"
+#include "dwt.h"
+#include "clib.h"
+#include <string.h>
+
+#if configUSE_PROFILER == 1
+
+#define PROFILE_NAME(id) #id,
+static const char *const profile_names[PROFILE_REGION_COUNT] = {
+    PROFILE_REGIONS(PROFILE_NAME)
+};
+
+static struct profile_stats profile_stats[PROFILE_REGION_COUNT];
+
+/* -1 until the cycle counter is probed, then whether it counts. */
+static int profile_dwt = -1;
+
+static inline unsigned long profile_irq_save(void)
+{
+    unsigned long primask;
+
+    __asm volatile ("mrs %0, primask\n"
+                    "cpsid i\n" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void profile_irq_restore(unsigned long primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+unsigned long profile_cycles(void)
+{
+    if (profile_dwt < 0)
+        profile_dwt = dwt_start();
+    return profile_dwt ? DWT_CYCCNT : clock_cycles();
+}
+
+static void profile_reset(struct profile_stats *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->min = ~0UL;
+}
+
+void profile_record(enum profile_region region, unsigned long cycles)
+{
+    struct profile_stats *s = &profile_stats[region];
+    unsigned long primask = profile_irq_save();
+
+    /* Counted from the first pass so static storage needs no set up. */
+    if (s->count == 0)
+        s->min = ~0UL;
+    s->count++;
+    s->total += cycles;
+    if (cycles < s->min)
+        s->min = cycles;
+    if (cycles > s->max)
+        s->max = cycles;
+    s->histogram[cycles ? 31 - __builtin_clz(cycles) : 0]++;
+    profile_irq_restore(primask);
+}
+
+static void prof_regions(void)
+{
+    struct profile_stats s;
+    unsigned long primask;
+    int i, b;
+
+    fio_printf(1, "Cycles from %s\r\n",
+               profile_dwt > 0 ? "DWT CYCCNT" : "clock_cycles()");
+    fio_printf(1, "region                     count       avg       min       max\r\n");
+    for (i = 0; i < PROFILE_REGION_COUNT; i++) {
+        primask = profile_irq_save();
+        s = profile_stats[i];
+        profile_irq_restore(primask);
+
+        fio_printf(1, "%-24s %7lu", profile_names[i], s.count);
+        if (s.count == 0) {
+            fio_printf(1, "\r\n");
+            continue;
+        }
+        fio_printf(1, " %9lu %9lu %9lu\r\n", s.total / s.count, s.min, s.max);
+        for (b = 0; b < PROFILE_BUCKETS; b++)
+            if (s.histogram[b])
+                fio_printf(1, "    < 2^%-2d %7lu\r\n", b + 1, s.histogram[b]);
+    }
+}
+
+#if configUSE_DEFERRED_CALLS == 1
+/* From xPendFunctionCallFromISR() to the daemon calling the function, counted
+ * by the daemon itself. */
+static void prof_deferred(int reset)
+{
+    xDeferredStats s;
+
+    vDeferredGetStats(&s, reset);
+    if (reset)
+        return;
+    fio_printf(1, "calls %lu  overflows %lu  at most %u waiting\r\n",
+               s.ulCalls, s.ulOverflows, (unsigned int) s.uxHighWaterMark);
+    if (s.ulCalls)
+        fio_printf(1, "pend to call  avg %lu  max %lu cycles\r\n",
+                   s.ulLatencyTotal / s.ulCalls, s.ulLatencyMax);
+}
+
+#define PROF_USAGE "Usage: prof regions|latency|deferred|reset\r\n"
+#else
+#define PROF_USAGE "Usage: prof regions|latency|reset\r\n"
+#endif
+
+void prof_command(int n, char *argv[])
+{
+    unsigned long primask;
+    int i;
+
+    if (n > 1 && !strcmp(argv[1], "regions")) {
+        prof_regions();
+    } else if (n > 1 && !strcmp(argv[1], "latency")) {
+        latency_prof_report();
+#if configUSE_DEFERRED_CALLS == 1
+    } else if (n > 1 && !strcmp(argv[1], "deferred")) {
+        prof_deferred(0);
+#endif
+    } else if (n > 1 && !strcmp(argv[1], "reset")) {
+        primask = profile_irq_save();
+        for (i = 0; i < PROFILE_REGION_COUNT; i++)
+            profile_reset(&profile_stats[i]);
+        profile_irq_restore(primask);
+        latency_prof_reset();
+#if configUSE_DEFERRED_CALLS == 1
+        prof_deferred(1);
+#endif
+    } else {
+        fio_printf(1, PROF_USAGE);
+    }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "romfs.h"
 #include "osdebug.h"
 #include "hash-djb2.h"
+#include "profile.h"
 
 struct romfs_fds_t {
     const uint8_t * file;
@@ -67,15 +68,18 @@ static off_t romfs_seek(void * opaque, off_t offset, int whence) {
 const uint8_t * romfs_get_file_by_hash(const uint8_t * romfs, uint32_t h, uint32_t * len) {
     const uint8_t * meta;
 
+    PROFILE_BEGIN(romfs_get_file_by_hash);
     for (meta = romfs; get_unaligned(meta) && get_unaligned(meta + 4); meta += get_unaligned(meta + 4) + 12) {
         if (get_unaligned(meta) == h) {
             if (len) {
                 *len = get_unaligned(meta + 4);
             }
+            PROFILE_END(romfs_get_file_by_hash);
             return meta + 12;
         }
     }
 
+    PROFILE_END(romfs_get_file_by_hash);
     return NULL;
 }
 
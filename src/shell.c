@@ -2,12 +2,14 @@
 #include <stddef.h>
 #include "clib.h"
 #include <string.h>
+#include <stdlib.h>
 #include "fio.h"
 #include "filesystem.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "fast_mutex.h"
 #include "host.h"
 #include "linenoise.h"
 
@@ -31,8 +33,26 @@ void host_command(int, char **);
 void help_command(int, char **);
 void host_command(int, char **);
 void mmtest_command(int, char **);
+void bench_command(int, char **);
 void test_command(int, char **);
 void new_command(int, char **);
+void wait_command(int, char **);
+#if configUSE_TRACE_RECORDER == 1
+void trace_command(int, char **);
+#endif
+#if configUSE_SLAB_ALLOCATOR == 1
+void slab_command(int, char **);
+#endif
+#if configUSE_HEAP_INSTRUMENTATION == 1
+void meminfo_command(int, char **);
+void heapmap_command(int, char **);
+#endif
+#if INCLUDE_vTaskWalkStacks == 1
+void stacks_command(int, char **);
+#endif
+#if configUSE_PROFILER == 1
+void prof_command(int, char **);
+#endif
 void _command(int, char **);
 
 int parse_command_args(char *str, char *argv[]);
@@ -47,9 +67,27 @@ command cmd_list[]={
     MKCL(ps, "Report a snapshot of the current processes"),
     MKCL(host, "Run command on host"),
     MKCL(mmtest, "heap memory allocation test"),
+    MKCL(bench, "Run a kernel micro benchmark"),
     MKCL(help, "help"),
     MKCL(test, "test new function"),
     MKCL(new, "Start a new task and output to host"),
+    MKCL(wait, "Wait up to a timeout in ms for a key on stdin"),
+#if configUSE_TRACE_RECORDER == 1
+    MKCL(trace, "Record kernel events and dump them to host"),
+#endif
+#if configUSE_SLAB_ALLOCATOR == 1
+    MKCL(slab, "Show small allocation pool statistics"),
+#endif
+#if configUSE_HEAP_INSTRUMENTATION == 1
+    MKCL(meminfo, "Show heap usage, fragmentation and allocation sites"),
+    MKCL(heapmap, "List the free blocks of the heap"),
+#endif
+#if INCLUDE_vTaskWalkStacks == 1
+    MKCL(stacks, "Show stack high water marks and recommended sizes"),
+#endif
+#if configUSE_PROFILER == 1
+    MKCL(prof, "Show profiled code regions, critical section and deferred call latency"),
+#endif
     MKCL(, ""),
 };
 
@@ -108,22 +146,57 @@ int filedump(const char *filename){
 }
 
 void ps_command(int n, char *argv[]){
-    static xSemaphoreHandle ps_sem;
-    if(ps_sem == NULL){
-        ps_sem = xSemaphoreCreateMutex();
+    static xFastMutex ps_sem;
+    static int ps_sem_ready;
+    if(!ps_sem_ready){
+        vFastMutexInitialise(&ps_sem);
+        ps_sem_ready = 1;
     }
     static signed char buf[1024];
-    if( pdTRUE == xSemaphoreTake(ps_sem, 100)){ // Prevent buffer to be overwrite
+    if( pdPASS == xFastMutexTake(&ps_sem, 100)){ // Prevent buffer to be overwrite
         vTaskList(buf);
         fio_printf(1, "Name          State   Priority  Stack  Num\n\r");
         fio_printf(1, "*******************************************\n\r");
         fio_printf(1, "%s\r\n", buf + 2);	
-        xSemaphoreGive(ps_sem);
+#if configUSE_EDF_SCHEDULING == 1
+        vTaskListPeriodic(buf);
+        if(buf[0]){
+            fio_printf(1, "Periodic      Class   Period  Dline  Jobs  Miss  Worst\n\r");
+            fio_printf(1, "******************************************************\n\r");
+            fio_printf(1, "%s\r\n", buf);
+        }
+#endif
+#if configUSE_TICKLESS_IDLE == 1
+        {
+            unsigned long sleeps, suppressed;
+
+            vPortGetTicklessStats(&sleeps, &suppressed);
+            fio_printf(1, "Tickless idle: %lu of %lu ticks suppressed in %lu sleeps\r\n",
+                       suppressed, (unsigned long) xTaskGetTickCount(), sleeps);
+        }
+#endif
+        xFastMutexGive(&ps_sem);
     }else{
         fio_printf(2, "cannot obtain ps_sem\r\n");
     }
 }
 
+#if configUSE_SLAB_ALLOCATOR == 1
+void slab_command(int n, char *argv[]){
+    xSlabStats stats;
+    unsigned portBASE_TYPE i;
+
+    fio_printf(1, "Size  Blocks  InUse  MaxUse  Allocs  Fallbacks\r\n");
+    for(i = 0; xPortGetSlabStats(i, &stats) == pdTRUE; i++){
+        fio_printf(1, "%4u  %6u  %5u  %6u  %6lu  %9lu\r\n",
+                   (unsigned int)stats.xBlockSize, (unsigned int)stats.uxBlocks,
+                   (unsigned int)stats.uxInUse, (unsigned int)stats.uxMaxInUse,
+                   stats.ulAllocations, stats.ulFallbacks);
+    }
+    fio_printf(1, "Heap free: %u bytes\r\n", (unsigned int)xPortGetFreeHeapSize());
+}
+#endif
+
 void cat_command(int n, char *argv[]){
     if(n==1){
         fio_printf(2, "Usage: cat <filename>\r\n");
@@ -201,6 +274,29 @@ void test_command(int n, char *argv[]) {
     host_action(SYS_CLOSE, handle);
 }
 
+/* Polls stdin with fio_poll(), which blocks in a queue set on the receive
+ * semaphore of the USART driver, and reads the key if one came in time. */
+void wait_command(int n, char *argv[]){
+    struct fio_pollfd fds[1];
+    int timeout = n > 1 ? atoi(argv[1]) : 5000;
+    portTickType start = xTaskGetTickCount();
+    int ready;
+    char c;
+
+    fds[0].fd = 0;
+    fds[0].events = FIO_POLLIN;
+    ready = fio_poll(fds, 1, timeout);
+    if (ready < 0) {
+        fio_printf(2, "wait: poll failed\r\n");
+    } else if (ready == 0) {
+        fio_printf(1, "No key in %d ms\r\n", timeout);
+    } else if (fds[0].revents & FIO_POLLIN) {
+        fio_read(0, &c, 1);
+        fio_printf(1, "Key 0x%02x after %u ms\r\n", (unsigned char) c,
+                   (unsigned int) ((xTaskGetTickCount() - start) * portTICK_RATE_MS));
+    }
+}
+
 void _command(int n, char *argv[]){
     (void)n; (void)argv;
 }
@@ -0,0 +1,189 @@
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "fio.h"
+#include "host.h"
+#include "clib.h"
+#include "stackstats.h"
+#include <string.h>
+
+#if INCLUDE_vTaskWalkStacks == 1
+
+/* Distinct task names reported by one walk, tasks sharing a name (those
+ * "new" starts) are merged and the deepest use kept. */
+#define STACKS_TASKS 16
+
+/* Words added to the deepest use seen, a quarter of it plus room for one
+ * more exception frame, before rounding up to a multiple of 8 words. */
+#define STACKS_MARGIN 16
+
+/* Same fill as the kernel uses for task stacks. */
+#define STACKS_FILL 0xa5
+
+/* Bytes left alone below the stack pointer when painting the main stack. */
+#define STACKS_PAINT_GAP 32
+
+#define STACKS_HEADER "output/stack_sizes.h"
+
+/* main.ld, the main stack is _eheap up to _estack. */
+extern unsigned char _eheap[];
+extern unsigned char _estack[];
+
+struct stack_usage {
+    char name[configMAX_TASK_NAME_LEN];
+    unsigned short depth;
+    unsigned short used;
+};
+
+struct stack_walk {
+    unsigned int count;
+    unsigned int missed;
+    struct stack_usage tasks[STACKS_TASKS];
+};
+
+void stackstats_paint_msp(void)
+{
+    volatile unsigned char *p;
+    unsigned char *sp;
+
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    for (p = _eheap; p < sp - STACKS_PAINT_GAP; p++)
+        *p = STACKS_FILL;
+}
+
+/* Bytes of the main stack never touched since stackstats_paint_msp(). */
+static unsigned int msp_free(void)
+{
+    unsigned char *p = _eheap;
+
+    while (p < _estack && *p == STACKS_FILL)
+        p++;
+    return p - _eheap;
+}
+
+static unsigned int stack_recommend(unsigned int used)
+{
+    return (used + used / 4 + STACKS_MARGIN + 7) & ~7U;
+}
+
+/* Runs with the scheduler suspended, only records. */
+static void stack_task(xTaskHandle task, const signed char *name,
+                       unsigned short depth, unsigned short min_free,
+                       void *param)
+{
+    struct stack_walk *walk = param;
+    struct stack_usage *u;
+    unsigned int i;
+
+    (void) task;
+    for (i = 0; i < walk->count; i++)
+        if (strcmp(walk->tasks[i].name, (const char *) name) == 0)
+            break;
+    if (i == STACKS_TASKS) {
+        walk->missed++;
+        return;
+    }
+
+    u = &walk->tasks[i];
+    if (i == walk->count) {
+        walk->count++;
+        strncpy(u->name, (const char *) name, configMAX_TASK_NAME_LEN - 1);
+        u->name[configMAX_TASK_NAME_LEN - 1] = '\0';
+        u->depth = 0;
+        u->used = 0;
+    }
+    if (depth > u->depth)
+        u->depth = depth;
+    if (depth - min_free > u->used)
+        u->used = depth - min_free;
+}
+
+/* "Tmr Svc" becomes STACK_SIZE_TMR_SVC. */
+static void stack_macro(char *macro, size_t n, const char *name)
+{
+    size_t i = strlen("STACK_SIZE_");
+
+    strncpy(macro, "STACK_SIZE_", n);
+    for (; *name && i < n - 1; name++, i++) {
+        if (*name >= 'a' && *name <= 'z')
+            macro[i] = *name - 'a' + 'A';
+        else if ((*name >= 'A' && *name <= 'Z') || (*name >= '0' && *name <= '9'))
+            macro[i] = *name;
+        else
+            macro[i] = '_';
+    }
+    macro[i] = '\0';
+}
+
+static int stacks_save(const char *filename, const struct stack_walk *walk,
+                       unsigned int msp_used)
+{
+    static const char head[] =
+        "/* Generated by \"stacks save\" from the high water marks of a run.\n"
+        " * Build with make STACK_SIZES=<this file>, depths are in words,\n"
+        " * MAIN_STACK_SIZE in bytes. */\n"
+        "#ifndef STACK_SIZES_H\n#define STACK_SIZES_H\n";
+    static const char tail[] = "#endif\n";
+    char line[64], macro[32];
+    unsigned int i;
+    int handle, error;
+
+    host_action(SYS_SYSTEM, "mkdir -p output");
+    handle = host_action(SYS_OPEN, filename, 4);
+    if (handle == -1)
+        return -1;
+
+    error = host_action(SYS_WRITE, handle, (void *) head, strlen(head));
+    for (i = 0; i < walk->count && !error; i++) {
+        stack_macro(macro, sizeof(macro), walk->tasks[i].name);
+        snprintf(line, sizeof(line), "#define %s %u\n", macro,
+                 stack_recommend(walk->tasks[i].used));
+        error = host_action(SYS_WRITE, handle, line, strlen(line));
+    }
+    if (!error) {
+        snprintf(line, sizeof(line), "#define MAIN_STACK_SIZE %u\n",
+                 stack_recommend(msp_used / 4) * 4);
+        error = host_action(SYS_WRITE, handle, line, strlen(line));
+    }
+    if (!error)
+        error = host_action(SYS_WRITE, handle, (void *) tail, strlen(tail));
+    host_action(SYS_CLOSE, handle);
+
+    return error;
+}
+
+void stacks_command(int n, char *argv[])
+{
+    struct stack_walk walk;
+    unsigned int i, msp_size, msp_used;
+
+    walk.count = 0;
+    walk.missed = 0;
+    vTaskWalkStacks(stack_task, &walk);
+    msp_size = _estack - _eheap;
+    msp_used = msp_size - msp_free();
+
+    fio_printf(1, "Name              depth   used  recommended\r\n");
+    for (i = 0; i < walk.count; i++) {
+        struct stack_usage *u = &walk.tasks[i];
+
+        fio_printf(1, "%-16s  %5u  %5u  %5u%s\r\n", u->name, u->depth,
+                   u->used, stack_recommend(u->used),
+                   u->used >= u->depth ? "  OVERFLOW" : "");
+    }
+    if (walk.missed)
+        fio_printf(1, "(%u more tasks)\r\n", walk.missed);
+    fio_printf(1, "%-16s  %5u  %5u  %5u  (MSP, bytes)\r\n", "main/ISR",
+               msp_size, msp_used, stack_recommend(msp_used / 4) * 4);
+
+    if (n > 1 && strcmp(argv[1], "save") == 0) {
+        const char *filename = n > 2 ? argv[2] : STACKS_HEADER;
+
+        if (stacks_save(filename, &walk, msp_used))
+            fio_printf(2, "Cannot write %s\r\n", filename);
+        else
+            fio_printf(1, "Wrote %s\r\n", filename);
+    }
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host.h"
+#include "clib.h"
+
+#include <string.h>
+
+#if configUSE_TRACE_RECORDER == 1
+
+#if (TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) != 0
+#error TRACE_BUFFER_EVENTS must be a power of two
+#endif
+
+struct trace_buffer trace_buffer = {
+    .magic = TRACE_MAGIC,
+    .version = TRACE_VERSION,
+    .cpu_hz = configCPU_CLOCK_HZ,
+    .capacity = TRACE_BUFFER_EVENTS,
+};
+
+static volatile int trace_enabled = 1;
+static unsigned char trace_current_task;
+
+static inline unsigned long trace_irq_save(void)
+{
+    unsigned long primask;
+
+    __asm volatile ("mrs %0, primask\n"
+                    "cpsid i\n" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void trace_irq_restore(unsigned long primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+static inline unsigned long trace_ipsr(void)
+{
+    unsigned long ipsr;
+
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return ipsr & 0x1ff;
+}
+
+void trace_record(unsigned char type, unsigned short object)
+{
+    struct trace_event *event;
+    unsigned long primask;
+
+    if (!trace_enabled)
+        return;
+
+    primask = trace_irq_save();
+    event = &trace_buffer.events[trace_buffer.head & (TRACE_BUFFER_EVENTS - 1)];
+    event->timestamp = clock_cycles();
+    event->type = type;
+    event->task = trace_current_task;
+    event->object = object;
+    trace_buffer.head++;
+    trace_irq_restore(primask);
+}
+
+void trace_task_switched_in(unsigned char task)
+{
+    trace_current_task = task;
+    trace_record(TRACE_TASK_SWITCHED_IN, task);
+}
+
+void trace_task_create(unsigned char task, const char *name)
+{
+    /* Names are kept even while stopped so a later dump can label tasks
+     * created before recording started.  Only the first TRACE_MAX_TASKS task
+     * numbers get a slot, later ones show up by number. */
+    if (task < TRACE_MAX_TASKS)
+        strncpy(trace_buffer.names[task], name, TRACE_NAME_LEN - 1);
+    trace_record(TRACE_TASK_CREATE, task);
+}
+
+void trace_isr_enter(void)
+{
+    trace_record(TRACE_ISR_ENTER, (unsigned short) trace_ipsr());
+}
+
+void trace_isr_exit(void)
+{
+    trace_record(TRACE_ISR_EXIT, (unsigned short) trace_ipsr());
+}
+
+void trace_start(void)
+{
+    unsigned long primask = trace_irq_save();
+
+    trace_buffer.head = 0;
+    trace_enabled = 1;
+    trace_irq_restore(primask);
+}
+
+void trace_stop(void)
+{
+    trace_enabled = 0;
+}
+
+int trace_is_enabled(void)
+{
+    return trace_enabled;
+}
+
+/* Write the whole recorder state to a host file through semihosting.
+ * Recording is paused while the buffer is copied out. */
+int trace_dump(const char *filename)
+{
+    int enabled = trace_enabled;
+    int handle, error;
+
+    trace_enabled = 0;
+    host_action(SYS_SYSTEM, "mkdir -p output");
+    handle = host_action(SYS_OPEN, filename, 5);
+    if (handle == -1) {
+        trace_enabled = enabled;
+        return -1;
+    }
+
+    error = host_action(SYS_WRITE, handle, (void *) &trace_buffer,
+                        sizeof(trace_buffer));
+    host_action(SYS_CLOSE, handle);
+    trace_enabled = enabled;
+
+    return error;
+}
+
+/* Average cost of one trace_record() call in cycles, the best of a few
+ * batches so a tick landing in the middle does not skew the result.  The
+ * head is rewound afterwards, but the oldest events of a full ring are lost. */
+unsigned long trace_overhead(void)
+{
+    const int batches = 8, calls = 32;
+    unsigned long best = ~0UL, head, start, end;
+    int enabled = trace_enabled;
+    int i, j;
+
+    head = trace_buffer.head;
+    trace_enabled = 1;
+    for (i = 0; i < batches; i++) {
+        start = clock_cycles();
+        for (j = 0; j < calls; j++)
+            trace_record(TRACE_ISR_EXIT, 0);
+        end = clock_cycles();
+        if (end - start < best)
+            best = end - start;
+    }
+    trace_buffer.head = head;
+    trace_enabled = enabled;
+
+    return best / calls;
+}
+
+void trace_command(int n, char *argv[])
+{
+    const char *filename = "output/trace.bin";
+    unsigned long head = trace_buffer.head;
+
+    if (n == 1) {
+        fio_printf(1, "trace: %s, %lu/%d events, %lu dropped\r\n",
+                   trace_enabled ? "recording" : "stopped",
+                   head < TRACE_BUFFER_EVENTS ? head : TRACE_BUFFER_EVENTS,
+                   TRACE_BUFFER_EVENTS,
+                   head > TRACE_BUFFER_EVENTS ? head - TRACE_BUFFER_EVENTS : 0);
+    } else if (strcmp(argv[1], "start") == 0) {
+        trace_start();
+    } else if (strcmp(argv[1], "stop") == 0) {
+        trace_stop();
+    } else if (strcmp(argv[1], "dump") == 0) {
+        if (n > 2)
+            filename = argv[2];
+        if (trace_dump(filename) != 0)
+            fio_printf(2, "trace: cannot write %s\r\n", filename);
+        else
+            fio_printf(1, "trace: %u bytes written to %s\r\n",
+                       (unsigned int) sizeof(trace_buffer), filename);
+    } else if (strcmp(argv[1], "bench") == 0) {
+        fio_printf(1, "trace: %lu cycles per event\r\n", trace_overhead());
+    } else {
+        fio_printf(2, "Usage: trace [start|stop|dump [file]|bench]\r\n");
+    }
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+
+/* Runs src/mmtest.c on the host against one heap implementation, see
+ * mk/mmtest.mk.  The scheduler and critical section calls the heaps make
+ * become no-ops and the cycle counter is the monotonic clock in ns. */
+
+void mmtest_command(int n, char *argv[]);
+
+/* Only heap_5 has regions.  It gets configTOTAL_HEAP_SIZE like the others
+ * so the results compare allocators, not heap sizes. */
+void vPortDefineHeapRegions(const xHeapRegion * const regions) __attribute__((weak));
+
+static union {
+    unsigned long align;
+    unsigned char bytes[configTOTAL_HEAP_SIZE];
+} region;
+
+void vTaskSuspendAll(void) {
+}
+
+signed long xTaskResumeAll(void) {
+    return 0;
+}
+
+void vPortEnterCritical(void) {
+}
+
+void vPortExitCritical(void) {
+}
+
+unsigned long mmtest_cycles(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long) ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+size_t fio_printf(int fd, const char *format, ...) {
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vprintf(format, args);
+    va_end(args);
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    xHeapRegion regions[] = {
+        { region.bytes, sizeof(region.bytes) },
+        { NULL, 0 },
+    };
+
+    if (vPortDefineHeapRegions)
+        vPortDefineHeapRegions(regions);
+    mmtest_command(argc, argv);
+    return 0;
+}
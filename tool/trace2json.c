@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Converts a trace recorder dump (see include/trace.h) into the Chrome
+ * trace event format, viewable in chrome://tracing or Perfetto. */
+
+#define TRACE_MAGIC     0x52545246
+#define TRACE_VERSION   1
+#define TRACE_NAME_LEN  16
+#define TRACE_MAX_TASKS 16
+#define HEADER_SIZE     (5 * 4 + TRACE_MAX_TASKS * TRACE_NAME_LEN)
+#define EVENT_SIZE      8
+#define ISR_TID_BASE    1000
+#define MAX_EXCEPTIONS  512
+
+enum {
+    TRACE_TASK_SWITCHED_IN = 1,
+    TRACE_TASK_SWITCHED_OUT,
+    TRACE_TASK_CREATE,
+    TRACE_TASK_DELETE,
+    TRACE_TASK_DELAY,
+    TRACE_TASK_DELAY_UNTIL,
+    TRACE_TASK_READY,
+    TRACE_TASK_SUSPEND,
+    TRACE_TASK_RESUME,
+    TRACE_TASK_PRIORITY_INHERIT,
+    TRACE_TASK_PRIORITY_DISINHERIT,
+    TRACE_QUEUE_SEND,
+    TRACE_QUEUE_SEND_FAILED,
+    TRACE_QUEUE_RECEIVE,
+    TRACE_QUEUE_RECEIVE_FAILED,
+    TRACE_QUEUE_SEND_FROM_ISR,
+    TRACE_QUEUE_RECEIVE_FROM_ISR,
+    TRACE_BLOCKING_ON_QUEUE_SEND,
+    TRACE_BLOCKING_ON_QUEUE_RECEIVE,
+    TRACE_ISR_ENTER,
+    TRACE_ISR_EXIT,
+    TRACE_EVENT_TYPES
+};
+
+static const char *event_names[TRACE_EVENT_TYPES] = {
+    [TRACE_TASK_CREATE] = "task create",
+    [TRACE_TASK_DELETE] = "task delete",
+    [TRACE_TASK_DELAY] = "delay",
+    [TRACE_TASK_DELAY_UNTIL] = "delay until",
+    [TRACE_TASK_READY] = "ready",
+    [TRACE_TASK_SUSPEND] = "suspend",
+    [TRACE_TASK_RESUME] = "resume",
+    [TRACE_TASK_PRIORITY_INHERIT] = "priority inherit",
+    [TRACE_TASK_PRIORITY_DISINHERIT] = "priority disinherit",
+    [TRACE_QUEUE_SEND] = "queue send",
+    [TRACE_QUEUE_SEND_FAILED] = "queue send failed",
+    [TRACE_QUEUE_RECEIVE] = "queue receive",
+    [TRACE_QUEUE_RECEIVE_FAILED] = "queue receive failed",
+    [TRACE_QUEUE_SEND_FROM_ISR] = "queue send from ISR",
+    [TRACE_QUEUE_RECEIVE_FROM_ISR] = "queue receive from ISR",
+    [TRACE_BLOCKING_ON_QUEUE_SEND] = "block on queue send",
+    [TRACE_BLOCKING_ON_QUEUE_RECEIVE] = "block on queue receive",
+};
+
+static char names[TRACE_MAX_TASKS][TRACE_NAME_LEN + 1];
+static int task_running[256];
+static int isr_depth[MAX_EXCEPTIONS];
+static int isr_seen[MAX_EXCEPTIONS];
+static int first = 1;
+
+uint32_t read32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+void usage(const char *binname) {
+    printf("Usage: %s <trace.bin> [trace.json]\n", binname);
+    exit(-1);
+}
+
+const char *task_name(unsigned int task) {
+    static char buf[16];
+
+    /* Task numbers past the name table are still traced, under their own
+     * tid, but the recorder keeps no name for them. */
+    if (task < TRACE_MAX_TASKS && names[task][0])
+        return names[task];
+    sprintf(buf, "task %u", task);
+    return buf;
+}
+
+const char *isr_name(unsigned int exception) {
+    static char buf[16];
+
+    if (exception == 15)
+        return "SysTick";
+    if (exception < 16)
+        sprintf(buf, "exception %u", exception);
+    else
+        sprintf(buf, "IRQ %u", exception - 16);
+    return buf;
+}
+
+void emit(FILE *out, const char *fmt_head) {
+    fprintf(out, "%s\n  %s", first ? "" : ",", fmt_head);
+    first = 0;
+}
+
+void emit_thread_name(FILE *out, unsigned int tid, const char *name) {
+    char buf[128];
+
+    snprintf(buf, sizeof(buf), "{\"name\": \"thread_name\", \"ph\": \"M\", "
+             "\"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"%s\"}}", tid, name);
+    emit(out, buf);
+}
+
+void emit_event(FILE *out, const char *name, char ph, unsigned int tid,
+                double us, const char *extra) {
+    char buf[256];
+
+    snprintf(buf, sizeof(buf), "{\"name\": \"%s\", \"ph\": \"%c\", \"pid\": 1, "
+             "\"tid\": %u, \"ts\": %.3f%s}", name, ph, tid, us, extra);
+    emit(out, buf);
+}
+
+int main(int argc, char *argv[]) {
+    FILE *in, *out = stdout;
+    uint8_t header[HEADER_SIZE], *events;
+    uint32_t cpu_hz, capacity, head, count, start, i;
+    uint32_t last = 0;
+    uint64_t now = 0;
+    char extra[64];
+
+    if (argc < 2 || argc > 3)
+        usage(argv[0]);
+
+    if (!(in = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return -1;
+    }
+    if (fread(header, 1, HEADER_SIZE, in) != HEADER_SIZE
+        || read32(header) != TRACE_MAGIC) {
+        fprintf(stderr, "%s: not a trace dump\n", argv[1]);
+        return -1;
+    }
+    if (read32(header + 4) != TRACE_VERSION) {
+        fprintf(stderr, "%s: unsupported version %u\n", argv[1], read32(header + 4));
+        return -1;
+    }
+    cpu_hz = read32(header + 8);
+    capacity = read32(header + 12);
+    head = read32(header + 16);
+    for (i = 0; i < TRACE_MAX_TASKS; i++)
+        memcpy(names[i], header + 20 + i * TRACE_NAME_LEN, TRACE_NAME_LEN);
+
+    events = malloc(capacity * EVENT_SIZE);
+    if (fread(events, EVENT_SIZE, capacity, in) != capacity) {
+        fprintf(stderr, "%s: truncated dump\n", argv[1]);
+        return -1;
+    }
+    fclose(in);
+
+    if (argc == 3 && !(out = fopen(argv[2], "w"))) {
+        perror(argv[2]);
+        return -1;
+    }
+
+    /* Once the ring has wrapped the oldest event sits at head. */
+    count = head < capacity ? head : capacity;
+    start = head < capacity ? 0 : head % capacity;
+
+    fprintf(out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    emit(out, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, "
+         "\"args\": {\"name\": \"FreeRTOS\"}}");
+    for (i = 0; i < TRACE_MAX_TASKS; i++)
+        if (names[i][0])
+            emit_thread_name(out, i, names[i]);
+
+    for (i = 0; i < count; i++) {
+        const uint8_t *e = events + ((start + i) % capacity) * EVENT_SIZE;
+        uint32_t timestamp = read32(e);
+        unsigned int type = e[4], task = e[5], object = e[6] | (e[7] << 8);
+        double us;
+
+        /* Timestamps are a free running 32-bit cycle count. */
+        if (i != 0)
+            now += (uint32_t) (timestamp - last);
+        last = timestamp;
+        us = (double) now * 1000000.0 / cpu_hz;
+
+        switch (type) {
+        case TRACE_TASK_SWITCHED_IN:
+            object &= 0xff;
+            emit_event(out, task_name(object), 'B', object, us, "");
+            task_running[object] = 1;
+            break;
+        case TRACE_TASK_SWITCHED_OUT:
+            if (task_running[task]) {
+                emit_event(out, task_name(task), 'E', task, us, "");
+                task_running[task] = 0;
+            }
+            break;
+        case TRACE_ISR_ENTER:
+        case TRACE_ISR_EXIT:
+            object %= MAX_EXCEPTIONS;
+            if (!isr_seen[object]) {
+                emit_thread_name(out, ISR_TID_BASE + object, isr_name(object));
+                isr_seen[object] = 1;
+            }
+            if (type == TRACE_ISR_ENTER) {
+                isr_depth[object]++;
+                emit_event(out, isr_name(object), 'B', ISR_TID_BASE + object, us, "");
+            } else if (isr_depth[object] > 0) {
+                isr_depth[object]--;
+                emit_event(out, isr_name(object), 'E', ISR_TID_BASE + object, us, "");
+            }
+            break;
+        default:
+            if (type >= TRACE_EVENT_TYPES || !event_names[type])
+                break;
+            snprintf(extra, sizeof(extra), ", \"s\": \"t\", "
+                     "\"args\": {\"object\": %u}", object);
+            emit_event(out, event_names[type], 'i', task, us, extra);
+            break;
+        }
+    }
+
+    /* Close whatever was still running when the dump was taken. */
+    for (i = 0; i < 256; i++)
+        if (task_running[i])
+            emit_event(out, task_name(i), 'E', i,
+                       (double) now * 1000000.0 / cpu_hz, "");
+    for (i = 0; i < MAX_EXCEPTIONS; i++)
+        if (isr_depth[i] > 0)
+            emit_event(out, isr_name(i), 'E', ISR_TID_BASE + i,
+                       (double) now * 1000000.0 / cpu_hz, "");
+    fprintf(out, "\n]}\n");
+
+    if (out != stdout)
+        fclose(out);
+    free(events);
+
+    return 0;
+}